@@ -16,6 +16,8 @@
  * ------------------------------------------
  *
  */
+#include <algorithm>
+
 #include "common.h"
 #include "CDomain.h"
 #include "CDomainCartesian.h"
@@ -32,6 +34,14 @@ CDomain::CDomain(void)
 	this->pDevice			= NULL;
 	this->bPrepared			= false;
 	this->ucFloatSize		= 0;
+	this->ucStaticFloatSize	= 0;
+	this->bCellStateSoA		= false;
+	this->bDepthEncoding	= false;
+	this->ucPoleniMasks		= NULL;
+	this->ulWeirFaceIDs		= NULL;
+	this->ulWeirFaceCapacity= 0;
+	this->ulWeirFacesUsed	= 0;
+	this->bWeirFacesChanged	= false;
 	this->dMinFSL			= 9999.0;
 	this->dMaxFSL			= -9999.0;
 	this->dMinTopo			= 9999.0;
@@ -51,14 +61,24 @@ CDomain::~CDomain(void)
 	if ( this->ucFloatSize == 4 )
 	{
 		delete [] this->fCellStates;
-		delete [] this->fBedElevations;
-		delete [] this->fManningValues;
 	} else if ( this->ucFloatSize == 8 ) {
 		delete [] this->dCellStates;
+	}
+
+	if ( this->ucStaticFloatSize == 4 )
+	{
+		delete [] this->fBedElevations;
+		delete [] this->fManningValues;
+		delete [] this->fWeirFaceValues;
+	} else if ( this->ucStaticFloatSize == 8 ) {
 		delete [] this->dBedElevations;
 		delete [] this->dManningValues;
+		delete [] this->dWeirFaceValues;
 	}
 
+	delete [] this->ucPoleniMasks;
+	delete [] this->ulWeirFaceIDs;
+
 	if ( this->pScheme != NULL )     delete pScheme;
 
 	delete [] this->cSourceDir;
@@ -75,48 +95,54 @@ void	CDomain::createStoreBuffers(
 			void**			vArrayBedElevations,
 			void**			vArrayManningCoefs,
 			void**			vArrayBoundaryValues,
-			void**			vArrayPoleniValues,
-			void**			vArrayOpt_zxmax,
-			void**			vArrayOpt_cx,
-			void**			vArrayOpt_zymax,
-			void**			vArrayOpt_cy,
+			void**			vArrayPoleniMasks,
+			void**			vArrayWeirFaceIDs,
+			void**			vArrayWeirFaceValues,
 			void**			vArrayCouplingIDs,
 			void**			vArrayCouplingValues,
-			unsigned char	ucFloatSize
+			unsigned char	ucFloatSize,
+			unsigned char	ucStaticFloatSize,
+			bool			bCellStateSoA,
+			bool			bDepthEncoding
 		)
 {
 	if ( !bPrepared )
 		prepareDomain();
 
+	// Rebuilding the scheme with the same layout (e.g. when tuning) keeps the loaded data
+	if ( this->ucFloatSize == ucFloatSize &&
+		 this->ucStaticFloatSize == ucStaticFloatSize &&
+		 this->bCellStateSoA == bCellStateSoA &&
+		 this->bDepthEncoding == bDepthEncoding )
+	{
+		*vArrayCellStates		= static_cast<void*>( this->dCellStates );
+		*vArrayBedElevations	= static_cast<void*>( this->dBedElevations );
+		*vArrayManningCoefs		= static_cast<void*>( this->dManningValues );
+		*vArrayWeirFaceValues	= static_cast<void*>( this->dWeirFaceValues );
+		*vArrayPoleniMasks		= static_cast<void*>( this->ucPoleniMasks );
+		*vArrayWeirFaceIDs		= static_cast<void*>( this->ulWeirFaceIDs );
+
+		if ( this->getSummary().bUseOptimizedBoundary == false ) {
+			*vArrayBoundaryValues	= static_cast<void*>( this->dBoundaryValues );
+		} else {
+			*vArrayCouplingValues	= static_cast<void*>( this->dCouplingValues );
+			*vArrayCouplingIDs		= static_cast<void*>( this->ulCouplingIDs );
+		}
+		return;
+	}
+
 	this->ucFloatSize = ucFloatSize;
+	this->ucStaticFloatSize = ucStaticFloatSize;
+	this->bCellStateSoA = bCellStateSoA;
+	this->bDepthEncoding = bDepthEncoding;
 
 	try {
 		if ( ucFloatSize == sizeof( cl_float ) )
 		{
 			// Single precision
 			this->fCellStates		= new cl_float4[ this->ulCellCount ];
-			this->fBedElevations	= new cl_float[ this->ulCellCount ];
-			this->fManningValues	= new cl_float[ this->ulCellCount ];
-			this->fOpt_zxmaxValues	= new cl_float[ this->ulCellCount ];
-			this->fOpt_cxValues		= new cl_float[ this->ulCellCount ];
-			this->fOpt_zymaxValues	= new cl_float[ this->ulCellCount ];
-			this->fOpt_cyValues		= new cl_float[ this->ulCellCount ];
-
 			this->dCellStates		= (cl_double4*)( this->fCellStates );
-			this->dBedElevations	= (cl_double*)( this->fBedElevations );
-			this->dManningValues	= (cl_double*)( this->fManningValues );
-			this->dOpt_zxmaxValues	= (cl_double*)( this->fOpt_zxmaxValues);
-			this->dOpt_cxValues		= (cl_double*)( this->fOpt_cxValues);
-			this->dOpt_zymaxValues	= (cl_double*)( this->fOpt_zymaxValues);
-			this->dOpt_cyValues		= (cl_double*)( this->fOpt_cyValues);
-
 			*vArrayCellStates	 = static_cast<void*>( this->fCellStates );
-			*vArrayBedElevations = static_cast<void*>( this->fBedElevations );
-			*vArrayManningCoefs	 = static_cast<void*>( this->fManningValues );
-			*vArrayOpt_zxmax	 = static_cast<void*>( this->fOpt_zxmaxValues);
-			*vArrayOpt_cx		 = static_cast<void*>( this->fOpt_cxValues);
-			*vArrayOpt_zymax	 = static_cast<void*>( this->fOpt_zymaxValues);
-			*vArrayOpt_cy		 = static_cast<void*>( this->fOpt_cyValues);
 
 			if (this->getSummary().bUseOptimizedBoundary == false) {
 				this->fBoundaryValues	= new cl_float[ this->ulCellCount ];
@@ -133,28 +159,8 @@ void	CDomain::createStoreBuffers(
 		} else {
 			// Double precision
 			this->dCellStates		= new cl_double4[ this->ulCellCount ];
-			this->dBedElevations	= new cl_double[ this->ulCellCount ];
-			this->dManningValues	= new cl_double[ this->ulCellCount ];
-			this->dOpt_zxmaxValues  = new cl_double[ this->ulCellCount ];
-			this->dOpt_cxValues		= new cl_double[ this->ulCellCount ];
-			this->dOpt_zymaxValues  = new cl_double[ this->ulCellCount ];
-			this->dOpt_cyValues		= new cl_double[ this->ulCellCount ];
-
 			this->fCellStates		= (cl_float4*)( this->dCellStates );
-			this->fBedElevations	= (cl_float*)( this->dBedElevations );
-			this->fManningValues	= (cl_float*)( this->dManningValues );
-			this->fOpt_zxmaxValues  = (cl_float*)( this->dOpt_zxmaxValues);
-			this->fOpt_cxValues		= (cl_float*)( this->dOpt_cxValues);
-			this->fOpt_zymaxValues  = (cl_float*)( this->dOpt_zymaxValues);
-			this->fOpt_cyValues		= (cl_float*)( this->dOpt_cyValues);
-
 			*vArrayCellStates		= static_cast<void*>( this->dCellStates );
-			*vArrayBedElevations	= static_cast<void*>( this->dBedElevations );
-			*vArrayManningCoefs		= static_cast<void*>( this->dManningValues );
-			*vArrayOpt_zxmax		= static_cast<void*>( this->dOpt_zxmaxValues);
-			*vArrayOpt_cx			= static_cast<void*>( this->dOpt_cxValues);
-			*vArrayOpt_zymax		= static_cast<void*>( this->dOpt_zymaxValues);
-			*vArrayOpt_cy			= static_cast<void*>( this->dOpt_cyValues);
 
 			if (this->getSummary().bUseOptimizedBoundary == false) {
 				this->dBoundaryValues = new cl_double[this->ulCellCount];
@@ -171,8 +177,38 @@ void	CDomain::createStoreBuffers(
 			}
 
 		}
-		this->bPoleniValues			= new sUsePoleni[this->ulCellCount];
-		*vArrayPoleniValues			= static_cast<void*>(this->bPoleniValues);
+
+		// Static data can be held in single precision while the cell states are double
+		if ( ucStaticFloatSize == sizeof( cl_float ) )
+		{
+			this->fBedElevations	= new cl_float[ this->ulCellCount ];
+			this->fManningValues	= new cl_float[ this->ulCellCount ];
+
+			this->dBedElevations	= (cl_double*)( this->fBedElevations );
+			this->dManningValues	= (cl_double*)( this->fManningValues );
+
+			*vArrayBedElevations	= static_cast<void*>( this->fBedElevations );
+			*vArrayManningCoefs		= static_cast<void*>( this->fManningValues );
+		} else {
+			this->dBedElevations	= new cl_double[ this->ulCellCount ];
+			this->dManningValues	= new cl_double[ this->ulCellCount ];
+
+			this->fBedElevations	= (cl_float*)( this->dBedElevations );
+			this->fManningValues	= (cl_float*)( this->dManningValues );
+
+			*vArrayBedElevations	= static_cast<void*>( this->dBedElevations );
+			*vArrayManningCoefs		= static_cast<void*>( this->dManningValues );
+		}
+
+		this->ucPoleniMasks			= new cl_uchar[this->ulCellCount]();
+		*vArrayPoleniMasks			= static_cast<void*>(this->ucPoleniMasks);
+
+		// Weir faces are normally set once the scheme is built, so the table starts at
+		// the declared count and is sized to the faces actually set before upload
+		this->allocateWeirFaces( this->getWeirFaceCapacity() );
+		this->fillWeirFaces();
+		*vArrayWeirFaceValues		= static_cast<void*>( this->dWeirFaceValues );
+		*vArrayWeirFaceIDs			= static_cast<void*>( this->ulWeirFaceIDs );
 	}
 	catch( std::bad_alloc )
 	{
@@ -200,16 +236,15 @@ void	CDomain::initialiseMemory()
 			this->fCellStates[ i ].s[1]	= 0;	// Maximum free-surface level
 			this->fCellStates[ i ].s[2]	= 0;	// Discharge X
 			this->fCellStates[ i ].s[3]	= 0;	// Discharge Y
-			this->fBedElevations[ i ]   = 1;	// Bed elevation
-			this->fManningValues[ i ]	= 0;	// Manning coefficient
 		} else {
 			this->dCellStates[ i ].s[0]	= 0;	// Free-surface level
 			this->dCellStates[ i ].s[1]	= 0;	// Maximum free-surface level
 			this->dCellStates[ i ].s[2]	= 0;	// Discharge X
 			this->dCellStates[ i ].s[3]	= 0;	// Discharge Y
-			this->dBedElevations[ i ]   = 1;	// Bed elevation
-			this->dManningValues[ i ]	= 0;	// Manning coefficient
 		}
+
+		this->setBedElevation( i, 1 );		// Bed elevation
+		this->setManningCoefficient( i, 0 );	// Manning coefficient
 	}
 }
 
@@ -229,35 +264,27 @@ void	CDomain::resetAllValues()
 			this->fCellStates[ i ].s[1]		= 0.0;	// Maximum free-surface level
 			this->fCellStates[ i ].s[2]		= 0.0;	// Discharge X
 			this->fCellStates[ i ].s[3]		= 0.0;	// Discharge Y
-			this->fBedElevations[ i ]		= 0.0;	// Bed elevation
-			this->fManningValues[ i ]		= 0.0;	// Manning coefficient
 			if (this->getSummary().bUseOptimizedBoundary == false) {
 				this->fBoundaryValues[i] = 0.0;	// Boundary Values
 			}
-
-			this->fOpt_zxmaxValues[ i ]		= 0.0;	// Maxium elevation for poleni in X
-			this->fOpt_cxValues[ i ]		= 0.0;	// Poleni factor in X
-			this->fOpt_zymaxValues[ i ]		= 0.0;	// Maxium elevation for poleni in Y
-			this->fOpt_cyValues[ i ]		= 0.0;	// Poleni factor in Y
 		} else {
 			this->dCellStates[ i ].s[0]		= 0.0;	// Free-surface level
 			this->dCellStates[ i ].s[1]		= 0.0;	// Maximum free-surface level
 			this->dCellStates[ i ].s[2]		= 0.0;	// Discharge X
 			this->dCellStates[ i ].s[3]		= 0.0;	// Discharge Y
-			this->dBedElevations[ i ]		= 0.0;	// Bed elevation
-			this->dManningValues[ i ]		= 0.0;	// Manning coefficient
 			if (this->getSummary().bUseOptimizedBoundary == false) {
 				this->dBoundaryValues[ i ]	= 0.0;	// Boundary Values
 			}
-			this->dOpt_zxmaxValues[ i ]		= 0.0;	// Maxium elevation for poleni in X
-			this->dOpt_cxValues[ i ]		= 0.0;	// Poleni factor in X
-			this->dOpt_zymaxValues[ i ]		= 0.0;	// Maxium elevation for poleni in Y
-			this->dOpt_cyValues[ i ]		= 0.0;	// Poleni factor in Y
 		}
 
-		this->bPoleniValues[i] = {false,false,false,false};					// Poleni flags
+		this->setBedElevation( i, 0.0 );									// Bed elevation
+		this->setManningCoefficient( i, 0.0 );								// Manning coefficient
+		this->ucPoleniMasks[i] = 0;											// Poleni flags
 	}
 
+	this->mWeirFaces.clear();												// Weir faces
+	this->bWeirFacesChanged = true;
+
 	if (this->getSummary().bUseOptimizedBoundary == true) {
 		for (unsigned long i = 0; i < this->getSummary().ulCouplingArraySize; i++)
 		{
@@ -280,7 +307,7 @@ void	CDomain::resetAllValues()
  */
 void	CDomain::setBedElevation( unsigned long ulCellID, double dElevation )
 {
-	if ( this->ucFloatSize == 4 )
+	if ( this->ucStaticFloatSize == 4 )
 	{
 		this->fBedElevations[ ulCellID ] = static_cast<float>( dElevation );
 	} else {
@@ -293,7 +320,7 @@ void	CDomain::setBedElevation( unsigned long ulCellID, double dElevation )
  */
 void	CDomain::setManningCoefficient( unsigned long ulCellID, double dCoefficient )
 {
-	if ( this->ucFloatSize == 4 )
+	if ( this->ucStaticFloatSize == 4 )
 	{
 		this->fManningValues[ ulCellID ] = static_cast<float>( dCoefficient );
 	} else {
@@ -302,15 +329,32 @@ void	CDomain::setManningCoefficient( unsigned long ulCellID, double dCoefficient
 }
 
 /*
- *  Sets a state variable for a given cell
+ *  Gets the offset of a state variable in the cell state heap, which is held
+ *  either per cell or as four arrays of the cell count (FSL, max FSL, Qx, Qy)
+ */
+unsigned long	CDomain::getStateOffset( unsigned long ulCellID, unsigned char ucIndex )
+{
+	if ( this->bCellStateSoA )
+		return ucIndex * this->ulCellCount + ulCellID;
+	return ulCellID * 4 + ucIndex;
+}
+
+/*
+ *  Sets a state variable for a given cell, where levels are always given as
+ *  absolute levels and converted to depths if the states are depth-encoded
  */
 void	CDomain::setStateValue( unsigned long ulCellID, unsigned char ucIndex, double dValue )
 {
+	if ( this->bDepthEncoding &&
+		 ucIndex <= model::domainValueIndices::kValueMaxFreeSurfaceLevel &&
+		 dValue > -9999.0 )
+		dValue -= this->getBedElevation( ulCellID );
+
 	if ( this->ucFloatSize == 4 )
 	{
-		this->fCellStates[ ulCellID ].s[ ucIndex ] = static_cast<float>( dValue );
+		reinterpret_cast<cl_float*>( this->fCellStates )[ this->getStateOffset( ulCellID, ucIndex ) ] = static_cast<float>( dValue );
 	} else {
-		this->dCellStates[ ulCellID ].s[ ucIndex ] = dValue;
+		reinterpret_cast<cl_double*>( this->dCellStates )[ this->getStateOffset( ulCellID, ucIndex ) ] = dValue;
 	}
 }
 
@@ -319,7 +363,7 @@ void	CDomain::setStateValue( unsigned long ulCellID, unsigned char ucIndex, doub
  */
 double	CDomain::getBedElevation( unsigned long ulCellID )
 {
-	if ( this->ucFloatSize == 4 ) 
+	if ( this->ucStaticFloatSize == 4 ) 
 		return static_cast<double>( this->fBedElevations[ ulCellID ] );
 	return this->dBedElevations[ ulCellID ];
 }
@@ -329,7 +373,7 @@ double	CDomain::getBedElevation( unsigned long ulCellID )
  */
 double	CDomain::getManningCoefficient( unsigned long ulCellID )
 {
-	if ( this->ucFloatSize == 4 ) 
+	if ( this->ucStaticFloatSize == 4 ) 
 		return static_cast<double>( this->fManningValues[ ulCellID ] );
 	return this->dManningValues[ ulCellID ];
 }
@@ -345,13 +389,50 @@ double	CDomain::getBoundaryCondition( unsigned long ulCellID )
 }
 
 /*
- *  Gets a state variable for a given cell
+ *  Gets a state variable for a given cell, with levels as absolute levels
  */
 double	CDomain::getStateValue( unsigned long ulCellID, unsigned char ucIndex )
 {
+	double dValue;
+
+	if ( this->ucFloatSize == 4 ) 
+	{
+		dValue = static_cast<double>( reinterpret_cast<cl_float*>( this->fCellStates )[ this->getStateOffset( ulCellID, ucIndex ) ] );
+	} else {
+		dValue = reinterpret_cast<cl_double*>( this->dCellStates )[ this->getStateOffset( ulCellID, ucIndex ) ];
+	}
+
+	if ( this->bDepthEncoding &&
+		 ucIndex <= model::domainValueIndices::kValueMaxFreeSurfaceLevel &&
+		 dValue > -9999.0 )
+		dValue += this->getBedElevation( ulCellID );
+
+	return dValue;
+}
+
+/*
+ *  Gets the water depth for a given cell, which is held directly when the
+ *  states are depth-encoded rather than found from the level and the bed
+ */
+double	CDomain::getDepth( unsigned long ulCellID )
+{
+	if ( !this->bDepthEncoding )
+		return this->getStateValue( ulCellID, model::domainValueIndices::kValueFreeSurfaceLevel ) - this->getBedElevation( ulCellID );
+
+	double dDepth;
+
 	if ( this->ucFloatSize == 4 ) 
-		return static_cast<double>( this->fCellStates[ ulCellID ].s[ ucIndex ] );
-	return this->dCellStates[ ulCellID ].s[ ucIndex ];
+	{
+		dDepth = static_cast<double>( reinterpret_cast<cl_float*>( this->fCellStates )[ this->getStateOffset( ulCellID, model::domainValueIndices::kValueFreeSurfaceLevel ) ] );
+	} else {
+		dDepth = reinterpret_cast<cl_double*>( this->dCellStates )[ this->getStateOffset( ulCellID, model::domainValueIndices::kValueFreeSurfaceLevel ) ];
+	}
+
+	// Disabled cells hold the marker level rather than a depth
+	if ( dDepth <= -9999.0 )
+		return dDepth - this->getBedElevation( ulCellID );
+
+	return dDepth;
 }
 
 /*
@@ -490,56 +571,176 @@ void	CDomain::setOptimizedCouplingCondition(unsigned long index, double dCoeffic
 	}
 }
 /*
- *  Sets the Boundary values for a given cell
+ *  Sets the weir crest level on the east face of a given cell
  */
 void	CDomain::setZxmax(unsigned long ulCellID, double dCoefficient)
 {
-	if (this->ucFloatSize == 4)
-	{
-		this->fOpt_zxmaxValues[ulCellID] = static_cast<float>(dCoefficient);
-	}
-	else {
-		this->dOpt_zxmaxValues[ulCellID] = dCoefficient;
-	}
+	this->setWeirFaceValue(ulCellID * 2, 0, dCoefficient);
 }
 /*
- *  Sets the Boundary values for a given cell
+ *  Sets the Poleni coefficient on the east face of a given cell
  */
 void	CDomain::setcx(unsigned long ulCellID, double dCoefficient)
 {
-	if (this->ucFloatSize == 4)
+	this->setWeirFaceValue(ulCellID * 2, 1, dCoefficient);
+}
+/*
+ *  Sets the weir crest level on the north face of a given cell
+ */
+void	CDomain::setZymax(unsigned long ulCellID, double dCoefficient)
+{
+	this->setWeirFaceValue(ulCellID * 2 + 1, 0, dCoefficient);
+}
+/*
+ *  Sets the Poleni coefficient on the north face of a given cell
+ */
+void	CDomain::setcy(unsigned long ulCellID, double dCoefficient)
+{
+	this->setWeirFaceValue(ulCellID * 2 + 1, 1, dCoefficient);
+}
+/*
+ *  Number of entries in the weir face table. Until the scheme allocates it,
+ *  this is the number of faces declared for the domain or already set.
+ */
+unsigned long	CDomain::getWeirFaceCapacity()
+{
+	if ( this->ulWeirFaceIDs != NULL )
+		return this->ulWeirFaceCapacity;
+
+	return max( max( this->getSummary().ulWeirFaceCount, (unsigned long)this->mWeirFaces.size() ), 1UL );
+}
+/*
+ *  Find a weir face set for the domain by its ID (the cell ID times two, plus
+ *  one for the north face), adding it with a zero crest and coefficient
+ */
+cl_double2*	CDomain::getWeirFace(cl_ulong ulFaceID, bool bCreate)
+{
+	std::map<cl_ulong, cl_double2>::iterator itFace = this->mWeirFaces.find(ulFaceID);
+
+	if (itFace != this->mWeirFaces.end())
+		return &itFace->second;
+	if (!bCreate)
+		return NULL;
+
+	cl_double2 dFace;
+	dFace.s[0] = 0.0;
+	dFace.s[1] = 0.0;
+
+	this->bWeirFacesChanged = true;
+	return &this->mWeirFaces.insert(std::make_pair(ulFaceID, dFace)).first->second;
+}
+/*
+ *  Sets the crest level (0) or Poleni coefficient (1) of a weir face. Faces
+ *  which aren't weirs are left out of the table, as zero is the default.
+ */
+void	CDomain::setWeirFaceValue(cl_ulong ulFaceID, unsigned char ucIndex, double dValue)
+{
+	cl_double2* pFace = this->getWeirFace(ulFaceID, dValue != 0.0);
+	if (pFace == NULL)
+		return;
+
+	pFace->s[ucIndex] = dValue;
+	this->bWeirFacesChanged = true;
+}
+/*
+ *  Allocate the weir face table in the static float size
+ */
+void	CDomain::allocateWeirFaces(unsigned long ulCapacity)
+{
+	if (this->ucStaticFloatSize == 4)
 	{
-		this->fOpt_cxValues[ulCellID] = static_cast<float>(dCoefficient);
+		this->fWeirFaceValues	= new cl_float[ulCapacity * 2];
+		this->dWeirFaceValues	= (cl_double*)(this->fWeirFaceValues);
 	}
 	else {
-		this->dOpt_cxValues[ulCellID] = dCoefficient;
+		this->dWeirFaceValues	= new cl_double[ulCapacity * 2];
+		this->fWeirFaceValues	= (cl_float*)(this->dWeirFaceValues);
 	}
+	this->ulWeirFaceIDs			= new cl_ulong[ulCapacity];
+	this->ulWeirFaceCapacity	= ulCapacity;
 }
 /*
- *  Sets the Boundary values for a given cell
+ *  Copy the weir faces set into the table. The map is already ordered by face
+ *  ID, so the table comes out sorted for the kernels to binary search, and the
+ *  unused entries at the end hold the largest face ID.
  */
-void	CDomain::setZymax(unsigned long ulCellID, double dCoefficient)
+void	CDomain::fillWeirFaces()
 {
-	if (this->ucFloatSize == 4)
+	unsigned long ulFace = 0;
+
+	for (std::map<cl_ulong, cl_double2>::const_iterator itFace = this->mWeirFaces.begin(); itFace != this->mWeirFaces.end(); ++itFace, ++ulFace)
 	{
-		this->fOpt_zymaxValues[ulCellID] = static_cast<float>(dCoefficient);
+		this->ulWeirFaceIDs[ulFace] = itFace->first;
+		if (this->ucStaticFloatSize == 4)
+		{
+			this->fWeirFaceValues[ulFace * 2]		= static_cast<float>(itFace->second.s[0]);
+			this->fWeirFaceValues[ulFace * 2 + 1]	= static_cast<float>(itFace->second.s[1]);
+		}
+		else {
+			this->dWeirFaceValues[ulFace * 2]		= itFace->second.s[0];
+			this->dWeirFaceValues[ulFace * 2 + 1]	= itFace->second.s[1];
+		}
 	}
-	else {
-		this->dOpt_zymaxValues[ulCellID] = dCoefficient;
+	this->ulWeirFacesUsed = ulFace;
+
+	for (; ulFace < this->ulWeirFaceCapacity; ++ulFace)
+	{
+		this->ulWeirFaceIDs[ulFace] = CL_ULONG_MAX;
+		if (this->ucStaticFloatSize == 4)
+		{
+			this->fWeirFaceValues[ulFace * 2]		= 0.0;
+			this->fWeirFaceValues[ulFace * 2 + 1]	= 0.0;
+		}
+		else {
+			this->dWeirFaceValues[ulFace * 2]		= 0.0;
+			this->dWeirFaceValues[ulFace * 2 + 1]	= 0.0;
+		}
 	}
+
+	this->bWeirFacesChanged = false;
 }
 /*
- *  Sets the Boundary values for a given cell
+ *  Sort the weir faces set since the table was built into it, ready for upload.
+ *  The table only grows when there are more faces than it holds, and returns
+ *  true when the scheme was built for a different number of faces.
  */
-void	CDomain::setcy(unsigned long ulCellID, double dCoefficient)
+bool	CDomain::commitWeirFaces()
 {
-	if (this->ucFloatSize == 4)
+	if (!this->bWeirFacesChanged || this->ulWeirFaceIDs == NULL)
+		return false;
+
+	unsigned long	ulFacesUsed	= this->ulWeirFacesUsed;
+	bool			bResized	= false;
+
+	if (this->mWeirFaces.size() > this->ulWeirFaceCapacity)
 	{
-		this->fOpt_cyValues[ulCellID] = static_cast<float>(dCoefficient);
-	}
-	else {
-		this->dOpt_cyValues[ulCellID] = dCoefficient;
+		if (this->ucStaticFloatSize == 4)
+		{
+			delete [] this->fWeirFaceValues;
+		}
+		else {
+			delete [] this->dWeirFaceValues;
+		}
+		delete [] this->ulWeirFaceIDs;
+
+		try {
+			this->allocateWeirFaces(this->mWeirFaces.size());
+		}
+		catch( std::bad_alloc )
+		{
+			this->ulWeirFaceIDs = NULL;
+			model::doError(
+				"Domain memory allocation failure. Probably out of memory.",
+				model::errorCodes::kLevelFatal
+			);
+			return false;
+		}
+		bResized = true;
 	}
+
+	this->fillWeirFaces();
+
+	return bResized || this->ulWeirFacesUsed != ulFacesUsed;
 }
 /*
  *  Sets the Optimized Coupling Ids
@@ -561,9 +762,10 @@ void	CDomain::setPoleniConditionX(unsigned long ulCellID, bool UsePoleniInX)
 		unsigned long lIdxY = 0;
 		getCellIndices(ulCellID, &lIdxX, &lIdxY);
 		if (lIdxX < this->getSummary().ulColCount - 1) {
-			this->bPoleniValues[ulCellID].usePoliniE = true;
+			this->ucPoleniMasks[ulCellID] |= model::poleniFaces::kFaceE;
 			long ulCellID_Neigh_E = this->getNeighbourID(ulCellID, direction::east);
-			this->bPoleniValues[ulCellID_Neigh_E].usePoliniW = true;
+			this->ucPoleniMasks[ulCellID_Neigh_E] |= model::poleniFaces::kFaceW;
+			this->getWeirFace(ulCellID * 2, true);
 		}
 	}
 
@@ -582,9 +784,10 @@ void	CDomain::setPoleniConditionY(unsigned long ulCellID, bool UsePoleniInY)
 		unsigned long lIdxY = 0;
 		getCellIndices(ulCellID, &lIdxX, &lIdxY);
 		if (lIdxY < this->getSummary().ulRowCount - 1) {
-			this->bPoleniValues[ulCellID].usePoliniN = true;
+			this->ucPoleniMasks[ulCellID] |= model::poleniFaces::kFaceN;
 			long ulCellID_Neigh_N = this->getNeighbourID(ulCellID, direction::north);
-			this->bPoleniValues[ulCellID_Neigh_N].usePoliniS = true;
+			this->ucPoleniMasks[ulCellID_Neigh_N] |= model::poleniFaces::kFaceS;
+			this->getWeirFace(ulCellID * 2 + 1, true);
 		}
 	}
 
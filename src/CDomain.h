@@ -21,6 +21,7 @@
 
 #include "opencl.h"
 #include "CDomainBase.h"
+#include <map>
 
 // TODO: Make a CLocation class
 class CDomainCartesian;
@@ -54,7 +55,7 @@ class CDomain : public CDomainBase
 		virtual		void			logDetails() = 0;												// Log details about the domain
 		virtual		void			updateCellStatistics() = 0;										// Update the total number of cells calculation
 		virtual		double*			readBuffers_opt_h() = 0;										// Read the gpu buffers to a double*
-		void						createStoreBuffers( void**, void**, void**, void**, void**, void**, void**, void**, void**, void**, void**, unsigned char );	// Allocates memory and returns pointers to the three arrays
+		void						createStoreBuffers( void**, void**, void**, void**, void**, void**, void**, void**, void**, unsigned char, unsigned char, bool, bool );	// Allocates memory and returns pointers to the three arrays
 		void						initialiseMemory();												// Populate cells with default values
 		void						resetAllValues();												// Reset cell values to default values
 		void						handleInputData( unsigned long, double, unsigned char, unsigned char );	// Handle input data for varying state/static cell variables 
@@ -63,21 +64,27 @@ class CDomain : public CDomainBase
 		void						setBoundaryCondition( unsigned long, double );					// Sets the boundary coefficient for a cell
 		void						setOptimizedCouplingCondition( unsigned long, double );					// Sets the optimized coupling boundary coefficient for a cell
 
-		void						setZxmax( unsigned long, double );					// Sets the boundary coefficient for a cell
-		void						setcx( unsigned long, double );					// Sets the boundary coefficient for a cell
-		void						setZymax( unsigned long, double );					// Sets the boundary coefficient for a cell
-		void						setcy( unsigned long, double );					// Sets the boundary coefficient for a cell
+		void						setZxmax( unsigned long, double );					// Sets the weir crest level on the east face of a cell
+		void						setcx( unsigned long, double );					// Sets the Poleni coefficient on the east face of a cell
+		void						setZymax( unsigned long, double );					// Sets the weir crest level on the north face of a cell
+		void						setcy( unsigned long, double );					// Sets the Poleni coefficient on the north face of a cell
 
 		void						setOptimizedCouplingID(unsigned long, unsigned long);					// Sets the boundary coefficient for a cell
 
 		void						setPoleniConditionX( unsigned long, bool );						// Sets the poleni conditon in x for a cell
 		void						setPoleniConditionY( unsigned long, bool );						// Sets the poleni conditon in y for a cell
 		void						setStateValue( unsigned long, unsigned char, double );			// Sets a state variable
+		bool						commitWeirFaces();												// Sort the weir faces set into the table for upload
 		bool						isDoublePrecision() { return ( ucFloatSize == 8 ); };			// Are we using double-precision?
+		bool						isCellStateSoA()	{ return bCellStateSoA; };					// Are the cell states held as separate arrays?
+		bool						isDepthEncoded()	{ return bDepthEncoding; };					// Are the levels held as depths above the bed?
+		unsigned long				getWeirFaceCapacity();											// Number of entries in the weir face table
+		unsigned long				getWeirFacesUsed()		{ return ulWeirFacesUsed; };			// Number of weir faces in the table
 		double						getBedElevation( unsigned long );								// Gets the bed elevation for a cell
 		double						getManningCoefficient( unsigned long );							// Gets the manning coefficient for a cell
 		double						getBoundaryCondition( unsigned long );							// Gets the manning coefficient for a cell
 		double						getStateValue( unsigned long, unsigned char );					// Gets a state variable
+		double						getDepth( unsigned long );										// Gets the water depth for a cell
 		double						getMaxFSL()				{ return dMaxFSL; }						// Fetch the maximum FSL in the domain
 		double						getMinFSL()				{ return dMinFSL; }						// Fetch the minimum FSL in the domain
 		virtual double				getVolume();													// Calculate the total volume in all the cells
@@ -95,6 +102,9 @@ class CDomain : public CDomainBase
 
 		// Private variables
 		unsigned char		ucFloatSize;															// Size of floats used for cell data (bytes)
+		unsigned char		ucStaticFloatSize;														// Size of floats used for static cell data (bytes)
+		bool				bCellStateSoA;															// Cell states held as four arrays rather than per cell?
+		bool				bDepthEncoding;															// Levels held as depths above the bed?
 		char*				cSourceDir;																// Data source dir
 		char*				cTargetDir;																// Output target dir
 
@@ -102,23 +112,22 @@ class CDomain : public CDomainBase
 		cl_double*			dBedElevations;															// Heap for bed elevations
 		cl_double*			dManningValues;															// Heap for manning values
 		cl_double*			dBoundaryValues;														// Heap for boundary values
-		cl_double*			dOpt_zxmaxValues;														// Heap for opt_zxmax values
-		cl_double*			dOpt_cxValues;															// Heap for opt_cx values
-		cl_double*			dOpt_zymaxValues;														// Heap for opt_zymax values
-		cl_double*			dOpt_cyValues;															// Heap for opt_cy values
+		cl_double*			dWeirFaceValues;														// Heap for weir face crest levels and coefficients
 		cl_double*			dCouplingValues;														// Heap for optimized coupling values
 
 		cl_float4*			fCellStates;															// Heap for cell state date (single)
 		cl_float*			fBedElevations;															// Heap for bed elevations (single)
 		cl_float*			fManningValues;															// Heap for manning values (single)
 		cl_float*			fBoundaryValues;														// Heap for boundary values (single)
-		cl_float*			fOpt_zxmaxValues;														// Heap for opt_zxmax values (single)
-		cl_float*			fOpt_cxValues;															// Heap for opt_cx values (single)
-		cl_float*			fOpt_zymaxValues;														// Heap for opt_zymax values (single)
-		cl_float*			fOpt_cyValues;															// Heap for opt_cy values (single)
+		cl_float*			fWeirFaceValues;														// Heap for weir face crest levels and coefficients (single)
 		cl_float*			fCouplingValues;														// Heap for optimized coupling values (single)
 
-		sUsePoleni*			bPoleniValues;															// Heap for Struct of Poleni values
+		cl_uchar*			ucPoleniMasks;															// Heap for per cell Poleni face bitmasks
+		cl_ulong*			ulWeirFaceIDs;															// Heap for weir face IDs, sorted
+		unsigned long		ulWeirFaceCapacity;														// Number of weir faces allocated
+		unsigned long		ulWeirFacesUsed;														// Number of weir faces in use
+		std::map<cl_ulong, cl_double2>	mWeirFaces;													// Weir faces set since the table was built, by face ID
+		bool				bWeirFacesChanged;														// Weir faces set since the table was built?
 		cl_ulong*			ulCouplingIDs;															// Heap for optimized coupling IDs
 
 		cl_double			dMinFSL;																// Min and max FSLs in the domain used for rendering
@@ -133,6 +142,11 @@ class CDomain : public CDomainBase
 
 		// Private functions
 		unsigned char		getDataValueCode( char* );												// Get a raster dataset code from text description
+		unsigned long		getStateOffset( unsigned long, unsigned char );							// Get the offset of a state variable in the cell state heap
+		cl_double2*			getWeirFace( cl_ulong, bool );											// Find (or add) a weir face set for the domain
+		void				allocateWeirFaces( unsigned long );										// Allocate the weir face table
+		void				fillWeirFaces();														// Copy the weir faces set into the table, sorted
+		void				setWeirFaceValue( cl_ulong, unsigned char, double );					// Sets the crest level or coefficient of a weir face
 };
 
 #endif
@@ -53,6 +53,7 @@ class CDomainBase
 			unsigned char	ucFloatPrecision;
 			unsigned long	ulCouplingArraySize;
 			bool			bUseOptimizedBoundary;
+			unsigned long	ulWeirFaceCount;
 		};
 
 		struct mpiSignalDataProgress
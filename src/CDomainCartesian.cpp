@@ -16,6 +16,7 @@
  * ------------------------------------------
  *
  */
+#include <algorithm>
 #include <limits>
 #include <stdio.h>
 #include <cstring>
@@ -29,6 +30,8 @@
 #include "CExecutorControlOpenCL.h"
 #include "CDomainCartesian.h"
 
+using std::min;
+
 /*
  *  Constructor
  */
@@ -41,6 +44,8 @@ CDomainCartesian::CDomainCartesian(void)
 	this->ulCols					= std::numeric_limits<unsigned long>::quiet_NaN();
 	this->bUseOptimizedBoundary		= false;
 	this->ulCouplingArraySize		= 0;
+	this->ulWeirFaceCount			= 0;
+	this->uiCellTileRows			= 0;
 }
 
 /*
@@ -236,12 +241,77 @@ unsigned long	CDomainCartesian::getOptimizedCouplingSize()
 {
 	return this->ulCouplingArraySize;
 }
+
+/*
+ *  Set the number of weir (Poleni) faces expected in the domain. The table
+ *  is sized to the faces actually set before the simulation starts, but a
+ *  count declared up front saves rebuilding the scheme for them.
+ */
+void	CDomainCartesian::setWeirFaceCount(unsigned long value)
+{
+	this->ulWeirFaceCount = value;
+}
+
+/*
+ *  Get the number of weir (Poleni) faces expected in the domain
+ */
+unsigned long	CDomainCartesian::getWeirFaceCount()
+{
+	return this->ulWeirFaceCount;
+}
+/*
+ *  Set the height of the strips the cells are tiled in, or zero for plain
+ *  row-major order. Within a strip the cells are stored column by column,
+ *  so north and south neighbours are adjacent. This must be set before any
+ *  cell data is provided, as it changes what each cell ID refers to.
+ */
+void	CDomainCartesian::setCellTileRows(unsigned int value)
+{
+	this->uiCellTileRows = value;
+}
+
+/*
+ *  Get the height of the strips the cells are tiled in
+ */
+unsigned int	CDomainCartesian::getCellTileRows()
+{
+	return this->uiCellTileRows;
+}
+
 /*
  *  Get a cell ID from an X and Y index
  */
 unsigned long	CDomainCartesian::getCellID( unsigned long ulX, unsigned long ulY )
 {
-	return ( ulY * this->getCols() ) + ulX;
+	if ( this->uiCellTileRows <= 1 )
+		return ( ulY * this->getCols() ) + ulX;
+
+	// The last strip holds whatever rows are left over
+	unsigned long	ulStrip		= ulY / this->uiCellTileRows;
+	unsigned long	ulStripRow	= ulY - ulStrip * this->uiCellTileRows;
+	unsigned long	ulHeight	= min( static_cast<unsigned long>( this->uiCellTileRows ), this->getRows() - ulStrip * this->uiCellTileRows );
+
+	return ( ulStrip * this->uiCellTileRows * this->getCols() ) + ( ulX * ulHeight ) + ulStripRow;
+}
+
+/*
+ *  Get the X and Y index from a cell ID
+ */
+void	CDomainCartesian::getCellIndices( unsigned long ulID, unsigned long* lIdxX, unsigned long* lIdxY )
+{
+	if ( this->uiCellTileRows <= 1 )
+	{
+		*lIdxX = ulID % this->getCols();
+		*lIdxY = ( ulID - *lIdxX ) / this->getCols();
+		return;
+	}
+
+	unsigned long	ulStrip		= ulID / ( this->uiCellTileRows * this->getCols() );
+	unsigned long	ulOffset	= ulID - ulStrip * this->uiCellTileRows * this->getCols();
+	unsigned long	ulHeight	= min( static_cast<unsigned long>( this->uiCellTileRows ), this->getRows() - ulStrip * this->uiCellTileRows );
+
+	*lIdxX = ulOffset / ulHeight;
+	*lIdxY = ulStrip * this->uiCellTileRows + ( ulOffset % ulHeight );
 }
 
 /*
@@ -253,14 +323,8 @@ double	CDomainCartesian::getVolume()
 
 	for( unsigned int i = 0; i < this->ulCellCount; ++i )
 	{
-		if ( this->isDoublePrecision() )
-		{
-			dVolume += ( this->dCellStates[i].s[0] - this->dBedElevations[i] ) *
-					   this->dCellResolutionX * this->dCellResolutionY;
-		} else {
-			dVolume += ( this->fCellStates[i].s[0] - this->fBedElevations[i] ) *
-					   this->dCellResolutionX * this->dCellResolutionY;
-		}
+		dVolume += this->getDepth( i ) *
+				   this->dCellResolutionX * this->dCellResolutionY;
 	}
 
 	return dVolume;
@@ -305,7 +369,7 @@ double*	CDomainCartesian::readBuffers_opt_h()
 	// Read the data back first...
 	// TODO: Review whether this is necessary, isn't it a sync point anyway?
 	pDevice->blockUntilFinished();
-	pScheme->readDomainAll();
+	pScheme->readDomainFSL();
 	pDevice->blockUntilFinished();
 
 	unsigned long	ulCellID;
@@ -315,7 +379,7 @@ double*	CDomainCartesian::readBuffers_opt_h()
 	for (unsigned long iRow = 0; iRow < this->getRows(); ++iRow) {
 		for (unsigned long iCol = 0; iCol < this->getCols(); ++iCol) {
 			ulCellID = this->getCellID(iCol, iRow);
-			values[ulCellID] = this->getStateValue(ulCellID, model::domainValueIndices::kValueFreeSurfaceLevel) - this->getBedElevation(ulCellID);
+			values[iRow * this->getCols() + iCol] = this->getDepth(ulCellID);
 			//Volume += values[ulCellID];
 		}
 	}
@@ -343,6 +407,7 @@ CDomainBase::DomainSummary CDomainCartesian::getSummary()
 	pSummary.dResolutionY = this->dCellResolutionY;
 	pSummary.bUseOptimizedBoundary = this->bUseOptimizedBoundary;
 	pSummary.ulCouplingArraySize = this->ulCouplingArraySize;
+	pSummary.ulWeirFaceCount = this->ulWeirFaceCount;
 
 	return pSummary;
 }
@@ -63,10 +63,15 @@ class CDomainCartesian : public CDomain
 		void			setOptimizedCouplingSize(unsigned long);
 		bool			getUseOptimizedCoupling();
 		unsigned long	getOptimizedCouplingSize();
+		void			setWeirFaceCount(unsigned long);						// Set the number of weir faces expected
+		unsigned long	getWeirFaceCount();										// Get the number of weir faces expected
+		void			setCellTileRows(unsigned int);							// Set the height of the strips cells are tiled in
+		unsigned int	getCellTileRows();										// Get the height of the strips cells are tiled in
 		
 
 
 		virtual unsigned long	getCellID( unsigned long, unsigned long );		// Get the cell ID using an X and Y index
+		virtual void	getCellIndices( unsigned long, unsigned long*, unsigned long* );	// Get the X and Y index using a cell ID
 		double			getVolume();											// Calculate the amount of volume in all the cells
 		double*			readBuffers_opt_h();									// Read GPU Buffers
 		void			resetBoundaryCondition();								// Resets boundary condition
@@ -112,6 +117,8 @@ class CDomainCartesian : public CDomain
 		double			dCellResolutionY;
 		unsigned long	ulCouplingArraySize;
 		bool			bUseOptimizedBoundary;
+		unsigned long	ulWeirFaceCount;
+		unsigned int	uiCellTileRows;
 		unsigned long	ulRows;
 		unsigned long	ulCols;
 
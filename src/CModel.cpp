@@ -43,7 +43,7 @@ CModel::CModel(void)
 	this->dCurrentTime		= 0.0;
 	this->dSimulationTime	= 60;
 	this->dOutputFrequency	= 60;
-	this->bDoublePrecision	= true;
+	this->ucFloatPrecision	= model::floatPrecision::kDouble;
 
 	this->pProgressCoords.sX = -1;
 	this->pProgressCoords.sY = -1;
@@ -133,7 +133,7 @@ void CModel::logDetails()
 	this->log->writeLine( "  Name:               " + this->sModelName, true, wColour );
 	this->log->writeLine( "  Simulation length:  " + Util::secondsToTime( this->dSimulationTime ), true, wColour );
 	this->log->writeLine( "  Output frequency:   " + Util::secondsToTime( this->dOutputFrequency ), true, wColour );
-	this->log->writeLine( "  Floating-point:     " + (std::string)( this->getFloatPrecision() == model::floatPrecision::kDouble ? "Double-precision" : "Single-precision" ), true, wColour );
+	this->log->writeLine( "  Floating-point:     " + (std::string)( this->getFloatPrecision() == model::floatPrecision::kDouble ? "Double-precision" : ( this->getFloatPrecision() == model::floatPrecision::kDoubleFloat ? "Double-float" : "Single-precision" ) ), true, wColour );
 	this->log->writeDivide();
 }
 
@@ -225,10 +225,11 @@ double	CModel::getOutputFrequency()
  */
 void	CModel::setFloatPrecision( unsigned char ucPrecision )
 {
-	if ( !this->getExecutor()->getDevice()->isDoubleCompatible() )
+	// Double-float only needs single-precision support from the device
+	if ( !this->getExecutor()->getDevice()->isDoubleCompatible() && ucPrecision == model::floatPrecision::kDouble )
 		ucPrecision = model::floatPrecision::kSingle;
 
-	this->bDoublePrecision = ( ucPrecision == model::floatPrecision::kDouble );
+	this->ucFloatPrecision = ucPrecision;
 }
 
 /*
@@ -236,7 +237,7 @@ void	CModel::setFloatPrecision( unsigned char ucPrecision )
  */
 unsigned char	CModel::getFloatPrecision()
 {
-	return ( this->bDoublePrecision ? model::floatPrecision::kDouble : model::floatPrecision::kSingle );
+	return this->ucFloatPrecision;
 }
 
 /*
@@ -104,7 +104,7 @@ class CModel
 		unsigned int			selectedDevice;
 		std::string				sModelName;										// Short name for the model
 		std::string				sModelDescription;								// Short description of the model
-		bool					bDoublePrecision;								// Double precision enabled?
+		unsigned char			ucFloatPrecision;								// Floating point precision
 		double					dSimulationTime;								// Total length of simulations
 		double					dCurrentTime;									// Current simulation time
 		double					dVisualisationTime;								// Current visualisation time
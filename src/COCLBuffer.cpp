@@ -43,10 +43,12 @@ COCLBuffer::COCLBuffer(
 	this->pHostBlock		= NULL;
 	this->bExistsOnHost		= bExistsOnHost;
 	this->bReadOnly			= bReadOnly;
+	this->bImage			= false;
+	this->ulImageWidth		= 0;
+	this->ulImageHeight		= 0;
 	this->ulSize			= ulSize;
 	this->clContext			= pProgram->clContext;
 	this->uiDeviceID		= pProgram->getDevice()->uiDeviceNo;
-	this->clQueue			= pProgram->getDevice()->clQueue;
 	this->pDevice			= pProgram->getDevice();
 	this->clBuffer			= NULL;
 	this->fCallbackRead		= COCLDevice::defaultCallback;
@@ -147,6 +149,121 @@ bool COCLBuffer::createBufferAndInitialise()
 	return createBuffer();
 }
 
+/*
+ *  Create the OpenCL buffer as a region of another, already created, with the
+ *  host-copy held inside the parent's. The offset must meet the device's base
+ *  address alignment.
+ */
+bool COCLBuffer::createSubBuffer(
+		COCLBuffer*	pParent,
+		cl_ulong	ulOffset
+	)
+{
+	cl_int				iErrorID;
+	cl_buffer_region	clRegion;
+
+	if ( this->bInternalBlock && this->pHostBlock != NULL )
+		delete [] this->pHostBlock;
+
+	this->pHostBlock		= pParent->getHostBlock<cl_uchar*>() + ulOffset;
+	this->bInternalBlock	= false;
+
+	clRegion.origin			= static_cast<size_t>( ulOffset );
+	clRegion.size			= static_cast<size_t>( this->ulSize );
+
+	// Host pointer flags are inherited from the parent and cannot be given again
+	clBuffer = clCreateSubBuffer(
+		pParent->getBuffer(),
+		this->clFlags & ( CL_MEM_READ_WRITE | CL_MEM_READ_ONLY ),
+		CL_BUFFER_CREATE_TYPE_REGION,
+		&clRegion,
+		&iErrorID
+	);
+
+	if ( iErrorID != CL_SUCCESS )
+	{
+		model::doError(
+			"Memory sub-buffer creation failed for '" + this->sName + "'. Error " + toStringExact( iErrorID ) + ".",
+			model::errorCodes::kLevelModelStop
+		);
+		return false;
+	}
+
+	this->bReady = true;
+
+	return true;
+}
+
+/*
+ *  Create the OpenCL object as a 2D image instead of a buffer, so reads on
+ *  the device go through the texture cache. The host-copy is held row by
+ *  row with one pixel per element, and must fill the image exactly.
+ */
+bool COCLBuffer::createImage2D(
+		cl_ulong			ulWidth,
+		cl_ulong			ulHeight,
+		cl_channel_order	clOrder,
+		cl_channel_type		clType
+	)
+{
+	cl_int				iErrorID;
+	cl_image_format		clFormat;
+	cl_image_desc		clDescription;
+
+	if ( this->bInternalBlock && 
+		 this->bExistsOnHost &&
+		 this->pHostBlock == NULL &&
+		 this->ulSize != NULL )
+		allocateHostBlock( this->ulSize );
+
+	if ( ulWidth == 0 || ulHeight == 0 || this->ulSize % ( ulWidth * ulHeight ) != 0 )
+	{
+		model::doError( 
+			"Memory image '" + this->sName + "' does not match its dimensions.",
+			model::errorCodes::kLevelModelStop
+		);
+		return false;
+	}
+
+	clFormat.image_channel_order		= clOrder;
+	clFormat.image_channel_data_type	= clType;
+
+	memset( &clDescription, 0, sizeof( cl_image_desc ) );
+	clDescription.image_type			= CL_MEM_OBJECT_IMAGE2D;
+	clDescription.image_width			= static_cast<size_t>( ulWidth );
+	clDescription.image_height			= static_cast<size_t>( ulHeight );
+	clDescription.image_row_pitch		= ( this->pHostBlock != NULL && ( clFlags & CL_MEM_COPY_HOST_PTR ) ? static_cast<size_t>( this->ulSize / ulHeight ) : 0 );
+
+	clBuffer = clCreateImage(
+		this->clContext,
+		clFlags,
+		&clFormat,
+		&clDescription,
+		( clFlags & CL_MEM_COPY_HOST_PTR ? pHostBlock : NULL ),
+		&iErrorID
+	);
+
+	if ( iErrorID != CL_SUCCESS )
+	{
+		model::doError(
+			"Memory image creation failed for '" + this->sName + "'. Error " + toStringExact( iErrorID ) + ".",
+			model::errorCodes::kLevelModelStop
+		);
+		return false;
+	}
+
+	this->bImage		= true;
+	this->ulImageWidth	= ulWidth;
+	this->ulImageHeight	= ulHeight;
+	this->bReady		= true;
+
+	model::log->writeLine(
+		"Memory image created for '" + this->sName + "' with " + toStringExact( ulWidth ) + " x " + toStringExact( ulHeight ) + " pixels."
+	);
+
+	return true;
+}
+
 /*
  *  Set the location of the host-copy of the buffer if it's not within this class instance
  */
@@ -205,17 +322,23 @@ void COCLBuffer::queueReadPartial(cl_ulong ulOffset, size_t ulSize, void* pMemBl
 		
 	// Add a read buffer to the queue (non-blocking)
 	// Calling functions are expected to handle barriers etc.
-	cl_int	iReturn = clEnqueueReadBuffer(
-		this->clQueue,				// Device queue
-		clBuffer,					// Buffer object
-		CL_FALSE,					// Blocking?
-		ulOffset,					// Offset
-		ulSize,						// Size
-		pMemBlock,					// Target pointer
-		NULL,						// No. of events in wait list
-		NULL,						// Wait list
-		( fCallbackRead != NULL && fCallbackRead != COCLDevice::defaultCallback ? &clEvent : NULL )					// Event pointer
-	);
+	cl_int	iReturn;
+	if ( this->bImage )
+	{
+		iReturn = queueImageRows( false, ulOffset, ulSize, pMemBlock, ( fCallbackRead != NULL && fCallbackRead != COCLDevice::defaultCallback ? &clEvent : NULL ) );
+	} else {
+		iReturn = clEnqueueReadBuffer(
+			pDevice->clQueue,			// Device queue
+			clBuffer,					// Buffer object
+			CL_FALSE,					// Blocking?
+			ulOffset,					// Offset
+			ulSize,						// Size
+			pMemBlock,					// Target pointer
+			NULL,						// No. of events in wait list
+			NULL,						// Wait list
+			( fCallbackRead != NULL && fCallbackRead != COCLDevice::defaultCallback ? &clEvent : NULL )					// Event pointer
+		);
+	}
 
 	if ( iReturn != CL_SUCCESS )
 	{
@@ -273,17 +396,23 @@ void COCLBuffer::queueWritePartial(cl_ulong ulOffset, size_t ulSize, void* pMemB
 		
 	// Add a read buffer to the queue (non-blocking)
 	// Calling functions are expected to handle barriers etc.
-	cl_int	iReturn = clEnqueueWriteBuffer(
-		this->clQueue,				// Device queue
-		clBuffer,					// Buffer object
-		CL_FALSE,					// Blocking?
-		ulOffset,					// Offset
-		ulSize,						// Size
-		pMemBlock,					// Source pointer
-		NULL,						// No. of events in wait list
-		NULL,						// Wait list
-		( fCallbackWrite != NULL && fCallbackWrite != COCLDevice::defaultCallback ? &clEvent : NULL )					// Event pointer
-	);
+	cl_int	iReturn;
+	if ( this->bImage )
+	{
+		iReturn = queueImageRows( true, ulOffset, ulSize, pMemBlock, ( fCallbackWrite != NULL && fCallbackWrite != COCLDevice::defaultCallback ? &clEvent : NULL ) );
+	} else {
+		iReturn = clEnqueueWriteBuffer(
+			pDevice->clQueue,			// Device queue
+			clBuffer,					// Buffer object
+			CL_FALSE,					// Blocking?
+			ulOffset,					// Offset
+			ulSize,						// Size
+			pMemBlock,					// Source pointer
+			NULL,						// No. of events in wait list
+			NULL,						// Wait list
+			( fCallbackWrite != NULL && fCallbackWrite != COCLDevice::defaultCallback ? &clEvent : NULL )					// Event pointer
+		);
+	}
 
 	// Did any errors occur?
 	if ( iReturn != CL_SUCCESS )
@@ -318,4 +447,50 @@ void COCLBuffer::queueWritePartial(cl_ulong ulOffset, size_t ulSize, void* pMemB
 			return;
 		}
 	}
-}
\ No newline at end of file
+}
+
+/*
+ *  Queue a read or write of whole rows of an image, which is the only
+ *  region an offset and size in bytes can describe
+ */
+cl_int COCLBuffer::queueImageRows( bool bWrite, cl_ulong ulOffset, size_t ulSize, void* pMemBlock, cl_event* pEvent )
+{
+	cl_ulong	ulRowSize	= this->ulSize / this->ulImageHeight;
+	size_t		clOrigin[3]	= { 0, 0, 0 };
+	size_t		clRegion[3]	= { static_cast<size_t>( this->ulImageWidth ), 0, 1 };
+
+	if ( ulOffset % ulRowSize != 0 || ulSize % ulRowSize != 0 || ulSize == 0 )
+		return CL_INVALID_VALUE;
+
+	clOrigin[1]	= static_cast<size_t>( ulOffset / ulRowSize );
+	clRegion[1]	= static_cast<size_t>( ulSize / ulRowSize );
+
+	if ( bWrite )
+		return clEnqueueWriteImage(
+			pDevice->clQueue,			// Device queue
+			clBuffer,					// Image object
+			CL_FALSE,					// Blocking?
+			clOrigin,					// Origin
+			clRegion,					// Region
+			static_cast<size_t>( ulRowSize ),	// Row pitch
+			0,							// Slice pitch
+			pMemBlock,					// Source pointer
+			NULL,						// No. of events in wait list
+			NULL,						// Wait list
+			pEvent						// Event pointer
+		);
+
+	return clEnqueueReadImage(
+		pDevice->clQueue,			// Device queue
+		clBuffer,					// Image object
+		CL_FALSE,					// Blocking?
+		clOrigin,					// Origin
+		clRegion,					// Region
+		static_cast<size_t>( ulRowSize ),	// Row pitch
+		0,							// Slice pitch
+		pMemBlock,					// Target pointer
+		NULL,						// No. of events in wait list
+		NULL,						// Wait list
+		pEvent						// Event pointer
+	);
+}
@@ -41,6 +41,9 @@ public:
 	blockType		getHostBlock()						{ return static_cast<blockType>( this->pHostBlock ); }
 	bool			createBuffer();
 	bool			createBufferAndInitialise();
+	bool			createSubBuffer( COCLBuffer*, cl_ulong );
+	bool			createImage2D( cl_ulong, cl_ulong, cl_channel_order, cl_channel_type );
+	bool			isImage()							{ return bImage; }
 	void			setPointer( void*, cl_ulong );
 	void			allocateHostBlock( cl_ulong );
 	void			queueReadAll();
@@ -49,11 +52,11 @@ public:
 	void			queueWritePartial( cl_ulong, size_t, void* = NULL );
 
 protected:
+	cl_int			queueImageRows( bool, cl_ulong, size_t, void*, cl_event* );
 	cl_uint			uiDeviceID;
 	std::string		sName;
 	cl_mem_flags	clFlags;
 	cl_context		clContext;
-	cl_command_queue clQueue;
 	cl_mem			clBuffer;
 	void*			pHostBlock;
 	COCLDevice*		pDevice;
@@ -62,6 +65,9 @@ protected:
 	bool			bInternalBlock;
 	bool			bReadOnly;
 	bool			bExistsOnHost;
+	bool			bImage;
+	cl_ulong		ulImageWidth;
+	cl_ulong		ulImageHeight;
 	model::CallBackData			callBackData;
 	void (__stdcall *fCallbackRead)( cl_event, cl_int, void* );
 	void (__stdcall *fCallbackWrite)( cl_event, cl_int, void* );
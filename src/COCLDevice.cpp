@@ -41,6 +41,9 @@ COCLDevice::COCLDevice( cl_device_id clDevice, unsigned int iPlatformID, unsigne
 	this->bErrored				= false;
 	this->bBusy					= false;
 	this->clMarkerEvent			= NULL;
+	this->clQueue				= NULL;
+	this->bOutOfOrderQueue		= false;
+	this->pQueueOwner			= NULL;
 	this->cModel				= cModel;
 	this->callBackData.cModel	= this->cModel;
 
@@ -66,6 +69,7 @@ COCLDevice::~COCLDevice(void)
 	delete[] this->clDeviceVendor;
 	delete[] this->clDeviceOpenCLVersion;
 	delete[] this->clDeviceOpenCLDriver;
+	delete[] this->clDeviceExtensions;
 
 	model::log->writeLine( "An OpenCL device has been released (#" + toStringExact(this->uiDeviceNo) + ")." );
 }
@@ -154,6 +158,15 @@ void COCLDevice::getAllInfo()
 	vMemBlock							= this->getDeviceInfo( CL_DEVICE_MEM_BASE_ADDR_ALIGN );
 	this->clDeviceAlignBits				= *static_cast<cl_uint*>( vMemBlock );
 	delete[] vMemBlock;
+	vMemBlock							= this->getDeviceInfo( CL_DEVICE_IMAGE_SUPPORT );
+	this->clDeviceImageSupport			= *static_cast<cl_bool*>( vMemBlock );
+	delete[] vMemBlock;
+	vMemBlock							= this->getDeviceInfo( CL_DEVICE_IMAGE2D_MAX_WIDTH );
+	this->clDeviceImage2DMaxWidth		= *static_cast<size_t*>( vMemBlock );
+	delete[] vMemBlock;
+	vMemBlock							= this->getDeviceInfo( CL_DEVICE_IMAGE2D_MAX_HEIGHT );
+	this->clDeviceImage2DMaxHeight		= *static_cast<size_t*>( vMemBlock );
+	delete[] vMemBlock;
 
 	this->clDeviceMaxWorkItemSizes		= (size_t *)this->getDeviceInfo( CL_DEVICE_MAX_WORK_ITEM_SIZES );
 	this->clDeviceName					= (char *)this->getDeviceInfo( CL_DEVICE_NAME );
@@ -162,6 +175,7 @@ void COCLDevice::getAllInfo()
 	this->clDeviceVendor				= (char *)this->getDeviceInfo( CL_DEVICE_VENDOR );
 	this->clDeviceOpenCLVersion			= (char *)this->getDeviceInfo( CL_DEVICE_VERSION );
 	this->clDeviceOpenCLDriver			= (char *)this->getDeviceInfo( CL_DRIVER_VERSION );
+	this->clDeviceExtensions			= (char *)this->getDeviceInfo( CL_DEVICE_EXTENSIONS );
 }
 
 /*
@@ -243,6 +257,7 @@ void COCLDevice::logDevice()
 	pLog->writeLine( "  Max allocation:    " + toStringExact( this->clDeviceMaxMemAlloc / 1024 / 1024 ) + "MB", true, wColour );
 	pLog->writeLine( "  Max argument size: " + toStringExact( this->clDeviceMaxParamSize / 1024 ) + "kB", true, wColour );
 	pLog->writeLine( "  Double precision:  " + sDoubleSupport, true, wColour );
+	pLog->writeLine( "  Image support:     " + (std::string)( this->clDeviceImageSupport ? "Available, max " + toStringExact( this->clDeviceImage2DMaxWidth ) + " x " + toStringExact( this->clDeviceImage2DMaxHeight ) : "Not supported" ), true, wColour );
 
 	pLog->writeDivide();
 }
@@ -286,7 +301,7 @@ void COCLDevice::createQueue()
 	this->clQueue = clCreateCommandQueue(
 		this->clContext,
 		this->clDevice,
-		0,
+		( this->bOutOfOrderQueue ? CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE : 0 ),
 		&iErrorID
 	);
 
@@ -380,6 +395,11 @@ void	COCLDevice::queueBarrier()
 	// Causes crashes... for some reason... Review later.
 	return;
 	#endif
+
+	// An in-order queue already finishes each command before the next starts
+	if ( !this->bOutOfOrderQueue )
+		return;
+
 	clEnqueueBarrier( this->clQueue );
 }
 
@@ -411,6 +431,84 @@ bool COCLDevice::isDoubleCompatible()
 		 ( CL_FP_FMA | CL_FP_ROUND_TO_NEAREST | CL_FP_ROUND_TO_ZERO | CL_FP_ROUND_TO_INF | CL_FP_INF_NAN | CL_FP_DENORM );
 }
 
+/*
+ *  Does the device list a specific extension?
+ */
+bool COCLDevice::isExtensionSupported( std::string sExtension )
+{
+	return std::strstr( this->clDeviceExtensions, sExtension.c_str() ) != NULL;
+}
+
+/*
+ *  Can commands on this device be executed out of order?
+ */
+bool COCLDevice::isOutOfOrderSupported()
+{
+	#ifdef USE_SIMPLE_ARCH_OPENCL
+	// Barriers are disabled, and they're all that keeps dependent commands apart
+	return false;
+	#endif
+
+	return ( this->clDeviceQueueProperties & CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE ) != 0;
+}
+
+/*
+ *  Can the device hold a 2D image with these dimensions?
+ */
+bool COCLDevice::isImage2DSupported( cl_ulong ulWidth, cl_ulong ulHeight )
+{
+	if ( !this->clDeviceImageSupport )
+		return false;
+
+	return ( ulWidth <= this->clDeviceImage2DMaxWidth && ulHeight <= this->clDeviceImage2DMaxHeight );
+}
+
+/*
+ *  Switch the command queue between in-order and out-of-order execution,
+ *  which recreates the queue once the existing one has drained. Every scheme
+ *  on the device shares the queue, so the first to set the mode owns it and
+ *  a different mode from any other scheme is rejected (returns false).
+ */
+bool COCLDevice::setOutOfOrderQueue( bool bOutOfOrder, CScheme* pOwner )
+{
+	cl_int	iErrorID;
+
+	if ( bOutOfOrder && !this->isOutOfOrderSupported() )
+		bOutOfOrder = false;
+
+	if ( this->pQueueOwner != NULL && this->pQueueOwner != pOwner )
+		return bOutOfOrder == this->bOutOfOrderQueue;
+
+	this->pQueueOwner = pOwner;
+
+	if ( bOutOfOrder == this->bOutOfOrderQueue || !this->clQueue )
+		return true;
+
+	clFinish( this->clQueue );
+
+	cl_command_queue clNewQueue = clCreateCommandQueue(
+		this->clContext,
+		this->clDevice,
+		( bOutOfOrder ? CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE : 0 ),
+		&iErrorID
+	);
+
+	if ( iErrorID != CL_SUCCESS ) 
+	{
+		model::doError( 
+			"Error recreating device command queue. The existing queue is kept.", 
+			model::errorCodes::kLevelWarning
+		);
+		return true;
+	}
+
+	clReleaseCommandQueue( this->clQueue );
+	this->clQueue			= clNewQueue;
+	this->bOutOfOrderQueue	= bOutOfOrder;
+
+	return true;
+}
+
 /*
  *  Release the event otherwise the 500 limit will be hit
  */
@@ -29,6 +29,7 @@
  *  Controls the model execution on a specific device
  */
 class CExecutorControlOpenCL;
+class CScheme;
 class COCLDevice
 {
 
@@ -81,7 +82,11 @@ class COCLDevice
 		char*						clDeviceVendor;
 		char*						clDeviceOpenCLVersion;
 		char*						clDeviceOpenCLDriver;			
+		char*						clDeviceExtensions;
 		cl_uint						clDeviceAlignBits;	
+		cl_bool						clDeviceImageSupport;
+		size_t						clDeviceImage2DMaxWidth;
+		size_t						clDeviceImage2DMaxHeight;
 
 		// Public functions
 		void						markBusy()							{ bBusy = true;  }					// Set the device as busy
@@ -92,6 +97,7 @@ class COCLDevice
 		char*						getVendor( void )					{ return clDeviceVendor; }			// Get vendor name
 		cl_device_type				getDeviceType( void )				{ return clDeviceType; }			// Get device type (bitmask)
 		char*						getOCLVersion( void )				{ return clDeviceOpenCLVersion; }	// Get OpenCL version
+		char*						getOCLCVersion( void )				{ return clDeviceCVersion; }		// Get OpenCL C version
 		void						getSummary( sDeviceSummary & );											// Get device summary info
 		bool						isBusy(void);															// Is the device busy?
 		std::string					getDeviceShortName( void );												// Fetch a short identifier for the device
@@ -100,6 +106,11 @@ class COCLDevice
 		bool						isReady( void );														// Is this device ready?	
 		bool						isFiltered( void );														// Is this device filtered from use?
 		bool						isDoubleCompatible( void );												// Is there sufficient double precision support?
+		bool						isExtensionSupported( std::string );									// Does the device list this extension?
+		bool						isOutOfOrderSupported( void );											// Can the queue execute out of order?
+		bool						isImage2DSupported( cl_ulong, cl_ulong );								// Can a 2D image of these dimensions be created?
+		bool						isOutOfOrderQueue( void )			{ return bOutOfOrderQueue; }		// Is the queue executing out of order?
+		bool						setOutOfOrderQueue( bool, CScheme* );									// Recreate the queue in/out of order for its owner
 		static void CL_CALLBACK		
 									defaultCallback( cl_event, cl_int, void * );							// Default event callback to dispose of the event	
 		void						queueBarrier();															// Queue a barrier to synchronise all threads
@@ -123,6 +134,8 @@ class COCLDevice
 		bool						bErrored;																// Serious error triggered
 		bool						bForceSinglePrecision;													// Force single precision only?
 		bool						bBusy;																	// Is this device busy?
+		bool						bOutOfOrderQueue;														// Is the queue out of order?
+		CScheme*					pQueueOwner;															// Scheme that chose the queue mode
 
 		// Private functions
 		void						getAllInfo();															// Fetches all the info we'll need on the device
@@ -42,9 +42,11 @@ COCLKernel::COCLKernel(
 	this->bGroupSizeForced	= false;
 	this->clProgram			= program->clProgram;
 	this->clKernel			= NULL;
+	this->clKernelAlternate	= NULL;
+	this->bUseAlternate		= false;
+	this->arguments			= NULL;
 	this->pDevice			= program->getDevice();
 	this->uiDeviceID		= program->getDevice()->uiDeviceNo;
-	this->clQueue			= program->getDevice()->clQueue;
 	this->fCallback			= COCLDevice::defaultCallback;
 	this->szGlobalSize[0] = 1;	 this->szGlobalSize[1] = 1;	  this->szGlobalSize[2] = 1;
 	this->szGroupSize[0] = 1;	 this->szGroupSize[1] = 1;	  this->szGroupSize[2] = 1;
@@ -62,6 +64,8 @@ COCLKernel::~COCLKernel()
 {
 	if ( this->clKernel != NULL )
 		clReleaseKernel( clKernel );
+	if ( this->clKernelAlternate != NULL )
+		clReleaseKernel( clKernelAlternate );
 
 	delete [] arguments;
 }
@@ -79,8 +83,8 @@ void COCLKernel::scheduleExecution()
 	pDevice->markBusy();
 	
 	iErrorID = clEnqueueNDRangeKernel(
-		this->clQueue,
-		clKernel,
+		pDevice->clQueue,
+		( this->bUseAlternate && clKernelAlternate != NULL ? clKernelAlternate : clKernel ),
 		3,
 		szGlobalOffset,
 		szGlobalSize,
@@ -135,7 +139,7 @@ void COCLKernel::scheduleExecutionAndFlush()
 	scheduleExecution();
 
 	iErrorID = clFlush(
-		this->clQueue
+		pDevice->clQueue
 	);
 
 	if ( iErrorID != CL_SUCCESS )
@@ -185,7 +189,7 @@ bool COCLKernel::assignArguments(
 }
 	
 /*
- *  Assign a single argument
+ *  Assign a single argument, to the alternate kernel too where there is one
  */
 bool COCLKernel::assignArgument(
 		unsigned char	ucArgumentIndex,
@@ -195,6 +199,8 @@ bool COCLKernel::assignArgument(
 	cl_int	iErrorID;
 	cl_mem	clBuffer = aBuffer->getBuffer();
 
+	this->arguments[ ucArgumentIndex ] = aBuffer;
+
 	iErrorID = clSetKernelArg(
 		clKernel,
 		ucArgumentIndex,
@@ -205,6 +211,74 @@ bool COCLKernel::assignArgument(
 	if ( iErrorID != CL_SUCCESS )
 		return false;
 
+	if ( this->clKernelAlternate != NULL )
+		return this->assignAlternateArgument( ucArgumentIndex, aBuffer );
+
+	return true;
+}
+
+/*
+ *  Assign a single argument to the alternate kernel only, so that swapping
+ *  buffers between iterations is a choice of kernel rather than new arguments
+ */
+bool COCLKernel::assignAlternateArgument(
+		unsigned char	ucArgumentIndex,
+		COCLBuffer*		aBuffer
+	)
+{
+	cl_int	iErrorID;
+	cl_mem	clBuffer = aBuffer->getBuffer();
+
+	if ( this->clKernelAlternate == NULL && !this->prepareAlternateKernel() )
+		return false;
+
+	iErrorID = clSetKernelArg(
+		clKernelAlternate,
+		ucArgumentIndex,
+		sizeof( &clBuffer ),
+		&clBuffer
+	);
+
+	if ( iErrorID != CL_SUCCESS )
+		return false;
+
+	return true;
+}
+
+/*
+ *  Create a second instance of the kernel, starting with the same arguments
+ */
+bool COCLKernel::prepareAlternateKernel()
+{
+	cl_int		iErrorID;
+	cl_mem		clBuffer;
+
+	clKernelAlternate = clCreateKernel(
+		clProgram,
+		sName.c_str(),
+		&iErrorID
+	);
+
+	if ( iErrorID != CL_SUCCESS )
+	{
+		clKernelAlternate = NULL;
+		model::doError(
+			"Could not prepare an alternate '" + sName + "' kernel. Error " + toStringExact( iErrorID ) + ".",
+			model::errorCodes::kLevelModelStop
+		);
+		return false;
+	}
+
+	for( cl_uint i = 0; i < this->uiArgumentCount; i++ )
+	{
+		if ( this->arguments[ i ] == NULL )
+			continue;
+
+		clBuffer = this->arguments[ i ]->getBuffer();
+		if ( clSetKernelArg( clKernelAlternate, i, sizeof( &clBuffer ), &clBuffer ) != CL_SUCCESS )
+			return false;
+	}
+
 	return true;
 }
 
@@ -317,7 +391,7 @@ void COCLKernel::prepareKernel()
 		this->ulMemLocal = 0;
 	}
 
-	this->arguments = new COCLBuffer*[ this->uiArgumentCount ];
+	this->arguments = new COCLBuffer*[ this->uiArgumentCount ]();
 	
 	model::log->writeLine( "Kernel '" + sName + "' is defined:" ); 
 	model::log->writeLine( "  Private memory:   " + toStringExact( this->ulMemPrivate ) + " bytes" ); 
@@ -44,17 +44,20 @@ public:
 	void			scheduleExecutionAndFlush();
 	bool			assignArguments( COCLBuffer* Buffer_Arguments[] );
 	bool			assignArgument( unsigned char Index, COCLBuffer* Buffer_Argument );
+	bool			assignAlternateArgument( unsigned char Index, COCLBuffer* Buffer_Argument );
+	void			setAlternate( bool Use_Alternate )				{ bUseAlternate = Use_Alternate; }
 	void			setGlobalSize( cl_ulong = 1, cl_ulong = 1, cl_ulong = 1 );
 	void			setGlobalOffset( cl_ulong = 0, cl_ulong = 0, cl_ulong = 0 );
 	void			setGroupSize( cl_ulong = 1, cl_ulong = 1, cl_ulong = 1 );
 
 protected:
 	void			prepareKernel();
+	bool			prepareAlternateKernel();
 
 	cl_uint			uiDeviceID;
 	cl_kernel		clKernel;
+	cl_kernel		clKernelAlternate;
 	cl_program		clProgram;
-	cl_command_queue clQueue;
 	COCLDevice*		pDevice;
 	COCLProgram*	program;
 	COCLBuffer**	arguments;
@@ -67,6 +70,7 @@ protected:
 	std::string		sName;
 	bool			bReady;
 	bool			bGroupSizeForced;
+	bool			bUseAlternate;
 	model::CallBackData			callBackData;
 	void (__stdcall *fCallback)( cl_event, cl_int, void* );
 };
@@ -35,6 +35,8 @@ COCLProgram::COCLProgram(
 	this->clProgram				= NULL;
 	this->clContext				= device->getContext();
 	this->bCompiled				= false;
+	this->bDoubleFloat			= false;
+	this->bSubGroups			= false;
 	this->sCompileParameters	= "";
 }
 
@@ -66,8 +68,14 @@ bool COCLProgram::compileProgram(
 	if (this->bForceSinglePrecision)
 		this->sCompileParameters += " -cl-single-precision-constant";
 
-	// Some standard things we need
-	this->sCompileParameters += " -cl-mad-enable";
+	// Some standard things we need, but contracting products would break the
+	// error-free transforms used for double-float
+	if (!this->bDoubleFloat)
+		this->sCompileParameters += " -cl-mad-enable";
+
+	// Sub-group built-ins are only declared from OpenCL C 2.0
+	if (this->bSubGroups)
+		this->sCompileParameters += ( std::strstr( this->device->getOCLCVersion(), "OpenCL C 3" ) != NULL ? " -cl-std=CL3.0" : " -cl-std=CL2.0" );
 #endif
 
 	// This might not be a good idea...
@@ -381,6 +389,14 @@ OCL_RAW_CODE	COCLProgram::getExtensionsHeader()
 		ssHeader << "typedef double4     cl_double4;" << std::endl;
 		ssHeader << "typedef double8     cl_double8;" << std::endl;
 		//ssHeader << "typedef double16     cl_double16;" << std::endl;
+	} else if ( this->bDoubleFloat ) {
+		// Doubles are floats, with pairs of floats for the emulated arithmetic
+		ssHeader << "#define DOUBLE_FLOAT		1" << std::endl;
+		ssHeader << "typedef float		cl_double;" << std::endl;
+		ssHeader << "typedef float2		cl_double2;" << std::endl;
+		ssHeader << "typedef float4		cl_double4;" << std::endl;
+		ssHeader << "typedef float8		cl_double8;" << std::endl;
+		ssHeader << "typedef float2		cl_dfloat;" << std::endl;
 	} else {
 		// Send warning to log
 		model::doError(
@@ -410,3 +426,20 @@ void	COCLProgram::setForcedSinglePrecision( bool bForce )
 	this->bForceSinglePrecision	= bForce;
 }
 
+/*
+ *  Should the state update be emulated as double-float? Only has an effect
+ *  when the device is forced to use single precision.
+ */
+void	COCLProgram::setDoubleFloat( bool bDoubleFloat )
+{
+	this->bDoubleFloat	= bDoubleFloat;
+}
+
+/*
+ *  Should the program be built for a version of OpenCL C with sub-groups?
+ */
+void	COCLProgram::setSubGroups( bool bSubGroups )
+{
+	this->bSubGroups	= bSubGroups;
+}
+
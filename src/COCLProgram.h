@@ -49,6 +49,8 @@ public:
 	bool						removeConstant( std::string );		
 	void						clearConstants();		
 	void						setForcedSinglePrecision( bool );
+	void						setDoubleFloat( bool );
+	void						setSubGroups( bool );
 	unsigned char				getFloatForm()						{ return ( bForceSinglePrecision ? model::floatPrecision::kSingle : model::floatPrecision::kDouble ); };
 	unsigned char				getFloatSize()						{ return ( bForceSinglePrecision ? sizeof( cl_float ) : sizeof( cl_double ) ); };
 
@@ -63,6 +65,8 @@ protected:
 	OCL_CODE_STACK				oclCodeStack;
 	bool						bCompiled;
 	bool						bForceSinglePrecision;
+	bool						bDoubleFloat;
+	bool						bSubGroups;
 	std::string					sCompileParameters;
 	std::unordered_map<std::string,std::string>					
 								uomConstants;
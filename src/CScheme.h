@@ -83,6 +83,7 @@ class CScheme
 		unsigned int		getIterationsSkipped()			{ return uiBatchSkipped; }				// Get the number of iterations skipped
 
 		virtual void		readDomainAll() = 0;													// Read back all domain data
+		virtual void		readDomainFSL() = 0;													// Read back the free-surface levels
 		virtual void		importLinkZoneData() = 0;												// Read back synchronisation zone data
 		virtual void		prepareSimulation() = 0;												// Set everything up to start running for this domain
 		virtual void		readKeyStatistics() = 0;												// Fetch the key statistics back to the right places in memory
@@ -17,6 +17,8 @@
  *
  */
 #include <algorithm>
+#include <fstream>
+#include <sstream>
 
 #include "common.h"
 #include "CDomainManager.h"
@@ -51,6 +53,27 @@ CSchemeGodunov::CSchemeGodunov()
 	this->dThresholdVerySmall			= 1E-10;
 	this->dThresholdQuiteSmall			= this->dThresholdVerySmall * 10;
 	this->bFrictionInFluxKernel			= true;
+	this->bReductionInFluxKernel		= false;
+	this->bBoundaryInFluxKernel			= false;
+	this->bActiveTiles					= false;
+	this->uiActiveTilesInterval			= 8;
+	this->uiIterationsSinceCompaction	= 0;
+	this->bWetExtent					= false;
+	this->bWetExtentValid				= false;
+	this->bCellStateSoA					= false;
+	this->bMixedPrecision				= false;
+	this->bDepthEncoding				= false;
+	this->uiCellTileRows				= 0;
+	this->uiTemporalBlockSteps			= 1;
+	this->uiStripCells					= 1;
+	this->bPersistentLoop				= false;
+	this->bStaticImages					= false;
+	this->bAtomicReduction				= false;
+	this->bOutOfOrderQueue				= false;
+	this->bAutotune						= false;
+	this->bAutotuning					= false;
+	this->bAutotuneCached				= false;
+	this->sAutotuneCache				= "autotune.cache";
 	this->bIncludeBoundaries			= false;
 	this->uiTimestepReductionWavefronts = 200;
 
@@ -78,16 +101,27 @@ CSchemeGodunov::CSchemeGodunov()
 	oclKernelTimeAdvance				= NULL;
 	oclKernelResetCounters				= NULL;
 	oclKernelTimestepUpdate				= NULL;
+	oclKernelTimestepResume				= NULL;
+	oclKernelBoundaryScatter			= NULL;
+	oclKernelTileFlag					= NULL;
+	oclKernelTilePin					= NULL;
+	oclKernelTileCompact				= NULL;
+	oclKernelTileSync					= NULL;
+	oclKernelWetExtent					= NULL;
+	oclKernelWetExtentCoupling			= NULL;
+	oclKernelWetSync					= NULL;
+	oclKernelPersistentLoop				= NULL;
 	oclBufferCellStates					= NULL;
 	oclBufferCellStatesAlt				= NULL;
 	oclBufferCellManning				= NULL;
 	oclBufferCellBoundary				= NULL;
-	oclBufferUsePoleni					= NULL;
-	oclBuffer_opt_zxmax					= NULL;
-	oclBuffer_opt_cx					= NULL;
-	oclBuffer_opt_zymax					= NULL;
-	oclBuffer_opt_cy					= NULL;
+	oclBufferPoleniMasks				= NULL;
+	oclBufferWeirFaceIDs				= NULL;
+	oclBufferWeirFaceValues				= NULL;
+	oclBufferCellFSLLow					= NULL;
 	oclBufferCellBed					= NULL;
+	oclBufferCellBedImage				= NULL;
+	oclBufferCellManningImage			= NULL;
 	oclBufferTimestep					= NULL;
 	oclBufferTimestepReduction			= NULL;
 	oclBufferTime						= NULL;
@@ -95,6 +129,18 @@ CSchemeGodunov::CSchemeGodunov()
 	oclBufferTimeHydrological			= NULL;
 	oclBufferCouplingIDs				= NULL;
 	oclBufferCouplingValues				= NULL;
+	oclBufferBoundaryRates				= NULL;
+	oclBufferTileFlags					= NULL;
+	oclBufferActiveTiles				= NULL;
+	oclBufferWetExtent					= NULL;
+	oclBufferIterationBudget			= NULL;
+	oclBufferBatchTimesteps				= NULL;
+	oclBufferBatchSuccessful			= NULL;
+	oclBufferBatchSkipped				= NULL;
+	oclBufferBatchStatus				= NULL;
+	ulBatchStatusReadSize				= 0;
+	ulBatchStatusStride					= 0;
+	ulBatchStatusExtraOffset			= 0;
 
 	if ( this->bDebugOutput )
 		model::doError( "Debug mode is enabled!", model::errorCodes::kLevelWarning );
@@ -129,6 +175,23 @@ void	CSchemeGodunov::setupScheme(model::SchemeSettings schemeSettings, CModel* c
 	this->setNonCachedWorkgroupSize(schemeSettings.CachedWorkgroupSize[0], schemeSettings.CachedWorkgroupSize[1]);
 	this->setCacheMode(schemeSettings.CacheMode);
 	this->setCacheConstraints(schemeSettings.CacheConstraints);
+	this->setReductionInFluxKernel(schemeSettings.ReductionInFluxKernel);
+	this->setBoundaryInFluxKernel(schemeSettings.BoundaryInFluxKernel);
+	this->setActiveTiles(schemeSettings.ActiveTiles);
+	this->setActiveTilesInterval(schemeSettings.ActiveTilesInterval);
+	this->setWetExtent(schemeSettings.WetExtent);
+	this->setCellStateSoA(schemeSettings.CellStateSoA);
+	this->setMixedPrecision(schemeSettings.MixedPrecision);
+	this->setDepthEncoding(schemeSettings.DepthEncoding);
+	this->setCellTileRows(schemeSettings.CellTileRows);
+	this->setTemporalBlockSteps(schemeSettings.TemporalBlockSteps);
+	this->setStripCells(schemeSettings.StripCells);
+	this->setStaticImages(schemeSettings.StaticImages);
+	this->setPersistentLoop(schemeSettings.PersistentLoop);
+	this->setAtomicReduction(schemeSettings.AtomicReduction);
+	this->setOutOfOrderQueue(schemeSettings.OutOfOrderQueue);
+	this->setAutotune(schemeSettings.Autotune);
+	this->setAutotuneCache(schemeSettings.AutotuneCacheFile);
 
 }
 
@@ -163,11 +226,25 @@ void CSchemeGodunov::logDetails()
 	model::log->writeLine( "  Timestep mode:      " + (std::string)( this->bDynamicTimestep ? "Dynamic" : "Fixed" ), true, wColour );
 	model::log->writeLine( "  Courant number:     " + (std::string)( this->bDynamicTimestep ? toStringExact( this->dCourantNumber ) : "N/A" ), true, wColour );
 	model::log->writeLine( "  Initial timestep:   " + Util::secondsToTime( this->dTimestep ), true, wColour );
-	model::log->writeLine( "  Data reduction:     " + toStringExact(this->uiTimestepReductionWavefronts) + " divisions", true, wColour);
+	model::log->writeLine( "  Data reduction:     " + this->getReductionDescription(), true, wColour);
 	model::log->writeLine( "  Riemann solver:     " + sSolver, true, wColour );
 	model::log->writeLine( "  Configuration:      " + sConfiguration, true, wColour );
+	model::log->writeLine( "  Fused reduction:    " + (std::string)( this->isReductionFused() ? "Enabled" : "Disabled" ), true, wColour );
+	model::log->writeLine( "  Fused boundaries:   " + (std::string)( this->isBoundaryFused() ? "Enabled" : "Disabled" ), true, wColour );
+	model::log->writeLine( "  Active tiles:       " + (std::string)( this->isActiveTilesEnabled() ? "Rebuilt every " + toStringExact( this->uiActiveTilesInterval ) + " iteration(s)" : "Disabled" ), true, wColour );
+	model::log->writeLine( "  Wet extent launch:  " + (std::string)( this->isWetExtentEnabled() ? "Enabled" : "Disabled" ), true, wColour );
+	model::log->writeLine( "  Cell state layout:  " + (std::string)( this->isCellStateSoAEnabled() ? "Structure of arrays" : "Array of structures" ), true, wColour );
+	model::log->writeLine( "  Static data:        " + (std::string)( this->getStaticFloatSize() == sizeof( cl_float ) ? "Single-precision" : "Double-precision" ), true, wColour );
+	model::log->writeLine( "  Stored levels:      " + (std::string)( this->isDepthEncodingEnabled() ? "Depth above bed" : "Free-surface level" ), true, wColour );
+	model::log->writeLine( "  Level update:       " + (std::string)( this->isDoubleFloatEnabled() ? "Double-float" : "Native" ), true, wColour );
+	model::log->writeLine( "  Cell ordering:      " + (std::string)( this->isCellTilingEnabled() ? "Strips of " + toStringExact( this->uiCellTileRows ) + " rows" : "Row-major" ), true, wColour );
+	model::log->writeLine( "  Strip mining:       " + (std::string)( this->isStripMiningEnabled() ? toStringExact( this->uiStripCells ) + " cells per work-item" : "Disabled" ), true, wColour );
+	model::log->writeLine( "  Bed and Manning:    " + (std::string)( this->isStaticImagesEnabled() ? "Images" : "Buffers" ), true, wColour );
+	model::log->writeLine( "  Zero timesteps:     " + (std::string)( this->isZeroTimestepSkipEnabled() ? "Skipped on device" : "Copied" ), true, wColour );
+	model::log->writeLine( "  Work-group size:    " + toStringExact( this->ulNonCachedWorkgroupSizeX ) + "x" + toStringExact( this->ulNonCachedWorkgroupSizeY ) + (std::string)( this->bAutotuneCached ? " (Tuned)" : "" ), true, wColour );
 	model::log->writeLine( "  Friction effects:   " + (std::string)( this->bFrictionEffects ? "Enabled" : "Disabled" ), true, wColour );
 	model::log->writeLine( "  Kernel queue mode:  " + (std::string)( this->bAutomaticQueue ? "Automatic" : "Fixed size" ), true, wColour );
+	model::log->writeLine( "  Command queue:      " + (std::string)( this->pDomain->getDevice()->isOutOfOrderQueue() ? "Out-of-order" : "In-order" ), true, wColour );
 	model::log->writeLine( (std::string)( this->bAutomaticQueue ? "  Initial queue:      " : "  Fixed queue:        " ) + toStringExact( this->uiQueueAdditionSize ) + " iteration(s)", true, wColour );
 	model::log->writeLine( "  Debug output:       " + (std::string)( this->bDebugOutput ? "Enabled" : "Disabled" ), true, wColour );
 
@@ -194,7 +271,14 @@ void CSchemeGodunov::prepareAll()
 	this->dCurrentTime					= 0;
 
 	// Forcing single precision?
-	this->oclModel->setForcedSinglePrecision(cModel->getFloatPrecision() == model::floatPrecision::kSingle );
+	this->oclModel->setForcedSinglePrecision(cModel->getFloatPrecision() != model::floatPrecision::kDouble );
+	this->oclModel->setSubGroups( this->isSubgroupReductionEnabled() );
+	if ( !this->prepareCommandQueue() )
+	{
+		this->releaseResources();
+		return;
+	}
+	this->oclModel->setDoubleFloat( this->isDoubleFloatEnabled() );
 
 	// OpenCL elements
 	if ( !this->prepare1OExecDimensions() ) 
@@ -247,7 +331,7 @@ void CSchemeGodunov::prepareAll()
 		return;
 	}
 
-	if ( !this->prepare1OKernels() ) 
+	if ( !this->prepare1OKernels() || !this->prepareAlternateKernels() ) 
 	{ 
 		model::doError(
 			"Failed to prepare kernels. Cannot continue.",
@@ -257,7 +341,6 @@ void CSchemeGodunov::prepareAll()
 		return;
 	}
 
-
 	this->logDetails();
 	this->bReady = true;
 }
@@ -382,187 +465,1265 @@ unsigned char	CSchemeGodunov::getCacheConstraints()
 }
 
 /*
- *  Calculate the dimensions for executing the problems (e.g. reduction glob/local sizes)
+ *  Set whether the timestep reduction should be carried out by the flux kernel
  */
-bool CSchemeGodunov::prepare1OExecDimensions()
+void	CSchemeGodunov::setReductionInFluxKernel( bool bReductionInFluxKernel )
 {
-	bool						bReturnState = true;
-	CExecutorControlOpenCL*		pExecutor	 = cModel->getExecutor();
-	COCLDevice*		pDevice		 = pExecutor->getDevice();
-	CDomainCartesian*			pDomain		 = static_cast<CDomainCartesian*>( this->pDomain );
+	this->bReductionInFluxKernel = bReductionInFluxKernel;
+}
 
-	// --
-	// Maximum permissible work-group dimensions for this device
-	// --
+/*
+ *  Get whether the timestep reduction should be carried out by the flux kernel
+ */
+bool	CSchemeGodunov::getReductionInFluxKernel()
+{
+	return this->bReductionInFluxKernel;
+}
 
-	cl_ulong	ulConstraintWGTotal = (cl_ulong)floor( sqrt( static_cast<double> ( pDevice->clDeviceMaxWorkGroupSize ) ) );
-	cl_ulong	ulConstraintWGDim   = min( pDevice->clDeviceMaxWorkItemSizes[0], pDevice->clDeviceMaxWorkItemSizes[1] );
-	cl_ulong	ulConstraintWG		= min( ulConstraintWGDim, ulConstraintWGTotal );
+/*
+ *  Is the timestep reduction actually fused into the flux kernel? Only the
+ *  non-cached kernels support this, and only for a dynamic timestep.
+ */
+bool	CSchemeGodunov::isReductionFused()
+{
+	return this->bReductionInFluxKernel &&
+		   this->bDynamicTimestep &&
+		   this->ucConfiguration == model::schemeConfigurations::godunovType::kCacheNone;
+}
 
-	// --
-	// Main scheme kernels with/without caching (2D)
-	// --
+/*
+ *  Set whether the boundary rates should be applied by the flux kernel
+ */
+void	CSchemeGodunov::setBoundaryInFluxKernel( bool bBoundaryInFluxKernel )
+{
+	this->bBoundaryInFluxKernel = bBoundaryInFluxKernel;
+}
 
-	if ( this->ulNonCachedWorkgroupSizeX == 0 )
-		ulNonCachedWorkgroupSizeX = ulConstraintWG;
-	if ( this->ulNonCachedWorkgroupSizeY == 0 )
-		ulNonCachedWorkgroupSizeY = ulConstraintWG;
+/*
+ *  Get whether the boundary rates should be applied by the flux kernel
+ */
+bool	CSchemeGodunov::getBoundaryInFluxKernel()
+{
+	return this->bBoundaryInFluxKernel;
+}
 
-	ulNonCachedGlobalSizeX	= pDomain->getCols();
-	ulNonCachedGlobalSizeY	= pDomain->getRows();
+/*
+ *  Are the boundary rates actually applied by the flux kernel? Only the
+ *  non-cached kernels support this, and a separate friction kernel would
+ *  otherwise change the order in which the two are applied.
+ */
+bool	CSchemeGodunov::isBoundaryFused()
+{
+	return this->bBoundaryInFluxKernel &&
+		   ( !this->bFrictionEffects || this->bFrictionInFluxKernel ) &&
+		   this->ucConfiguration == model::schemeConfigurations::godunovType::kCacheNone;
+}
 
-	if ( this->ulCachedWorkgroupSizeX == 0 )
-		ulCachedWorkgroupSizeX = ulConstraintWG +
-							 ( this->ucCacheConstraints == model::cacheConstraints::musclHancock::kCacheAllowUndersize ? -1 : 0 );
-	if ( this->ulCachedWorkgroupSizeY == 0 )
-		ulCachedWorkgroupSizeY = ulConstraintWG;
+/*
+ *  Get the per-cell boundary rates the flux kernel reads. The kernel only
+ *  reads these when the boundaries are fused, but an argument must be bound.
+ */
+COCLBuffer*	CSchemeGodunov::getBoundaryRateBuffer()
+{
+	if ( !this->bUseOptimizedBoundary )
+		return oclBufferCellBoundary;
+	if ( this->isBoundaryFused() )
+		return oclBufferBoundaryRates;
+	return oclBufferCouplingValues;
+}
 
-	ulCachedGlobalSizeX	= static_cast<unsigned long>( ceil( pDomain->getCols() * 
-						  ( this->ucConfiguration == model::schemeConfigurations::godunovType::kCacheEnabled ? static_cast<double>( ulCachedWorkgroupSizeX ) / static_cast<double>( ulCachedWorkgroupSizeX - 2 ) : 1.0 ) ) );
-	ulCachedGlobalSizeY	= static_cast<unsigned long>( ceil( pDomain->getRows() * 
-						  ( this->ucConfiguration == model::schemeConfigurations::godunovType::kCacheEnabled ? static_cast<double>( ulCachedWorkgroupSizeY ) / static_cast<double>( ulCachedWorkgroupSizeY - 2 ) : 1.0 ) ) );
+/*
+ *  Set whether only the active (wet) tiles of the domain are calculated
+ */
+void	CSchemeGodunov::setActiveTiles( bool bActiveTiles )
+{
+	this->bActiveTiles = bActiveTiles;
+}
 
-	// --
-	// Optimized Coupling
-	// --
-	this->bUseOptimizedBoundary	= pDomain->getSummary().bUseOptimizedBoundary;
-	this->ulCouplingArraySize	= pDomain->getSummary().ulCouplingArraySize;
+/*
+ *  Get whether only the active (wet) tiles of the domain are calculated
+ */
+bool	CSchemeGodunov::getActiveTiles()
+{
+	return this->bActiveTiles;
+}
 
+/*
+ *  Set the number of iterations between rebuilds of the active tiles
+ */
+void	CSchemeGodunov::setActiveTilesInterval( unsigned int uiInterval )
+{
+	this->uiActiveTilesInterval = uiInterval;
+}
 
-	// --
-	// Timestep reduction (2D)
-	// --
+/*
+ *  Get the number of iterations between rebuilds of the active tiles
+ */
+unsigned int	CSchemeGodunov::getActiveTilesInterval()
+{
+	return this->uiActiveTilesInterval;
+}
 
-	// TODO: May need to make this configurable?!
-	ulReductionWorkgroupSize = min(static_cast<size_t>(512), pDevice->clDeviceMaxWorkGroupSize);
-	//ulReductionWorkgroupSize = pDevice->clDeviceMaxWorkGroupSize / 2;
-	ulReductionGlobalSize = static_cast<unsigned long>( ceil( ( static_cast<double>(pDomain->getCellCount()) / this->uiTimestepReductionWavefronts ) / ulReductionWorkgroupSize ) * ulReductionWorkgroupSize );
+/*
+ *  Are the kernels actually restricted to the active tiles? Only the
+ *  non-cached kernels support this, with one tile per work-group.
+ */
+bool	CSchemeGodunov::isActiveTilesEnabled()
+{
+	return this->bActiveTiles &&
+		   this->ucConfiguration == model::schemeConfigurations::godunovType::kCacheNone;
+}
 
-	return bReturnState;
+/*
+ *  Set whether the launches are shrunk to the box around the wet cells
+ */
+void	CSchemeGodunov::setWetExtent( bool bWetExtent )
+{
+	this->bWetExtent = bWetExtent;
 }
 
 /*
- *  Allocate constants using the settings herein
+ *  Get whether the launches are shrunk to the box around the wet cells
  */
-bool CSchemeGodunov::prepare1OConstants()
+bool	CSchemeGodunov::getWetExtent()
 {
-	CDomainCartesian*	pDomain	= static_cast<CDomainCartesian*>( this->pDomain );
+	return this->bWetExtent;
+}
 
-	// --
-	// Dry cell threshold depths
-	// --
-	oclModel->registerConstant( "VERY_SMALL",			toStringExact( this->dThresholdVerySmall ) );
-	oclModel->registerConstant( "QUITE_SMALL",			toStringExact( this->dThresholdQuiteSmall ) );
+/*
+ *  Are the launches actually shrunk to the wet extent? Only the non-cached
+ *  kernels index cells from the global ID, and active tiles take precedence.
+ */
+bool	CSchemeGodunov::isWetExtentEnabled()
+{
+	return this->bWetExtent &&
+		   this->ucConfiguration == model::schemeConfigurations::godunovType::kCacheNone &&
+		   !this->isActiveTilesEnabled();
+}
 
-	// --
-	// Debug mode 
-	// --
+/*
+ *  Set whether the cell states are held as four arrays (FSL, max FSL, Qx, Qy)
+ */
+void	CSchemeGodunov::setCellStateSoA( bool bCellStateSoA )
+{
+	this->bCellStateSoA = bCellStateSoA;
+}
 
-	if ( this->bDebugOutput )
-	{
-		oclModel->registerConstant( "DEBUG_OUTPUT",		"1" );
-		oclModel->registerConstant( "DEBUG_CELLX",		std::to_string( this->uiDebugCellX ) );
-		oclModel->registerConstant( "DEBUG_CELLY",		std::to_string( this->uiDebugCellY ) );
-	} else {
-		oclModel->removeConstant( "DEBUG_OUTPUT" );
-		oclModel->removeConstant( "DEBUG_CELLX" );
-		oclModel->removeConstant( "DEBUG_CELLY" );
-	}
+/*
+ *  Get whether the cell states are held as four arrays
+ */
+bool	CSchemeGodunov::getCellStateSoA()
+{
+	return this->bCellStateSoA;
+}
 
-	// --
-	// Work-group size requirements
-	// --
+/*
+ *  Are the cell states actually held as four arrays? The cached kernels still
+ *  load whole cells into LDS, and the domain links copy contiguous rows.
+ */
+bool	CSchemeGodunov::isCellStateSoAEnabled()
+{
+	return this->bCellStateSoA &&
+		   this->ucConfiguration == model::schemeConfigurations::godunovType::kCacheNone &&
+		   cModel->getDomainSet()->getDomainCount() <= 1;
+}
 
-	if ( this->ucConfiguration == model::schemeConfigurations::godunovType::kCacheNone )
-	{
-		oclModel->registerConstant(
-			"REQD_WG_SIZE_FULL_TS",
-			"__attribute__((reqd_work_group_size(" + std::to_string( this->ulNonCachedWorkgroupSizeX )  + ", " + std::to_string( this->ulNonCachedWorkgroupSizeY )  + ", 1)))"
-		);
-	}
-	if ( this->ucConfiguration == model::schemeConfigurations::godunovType::kCacheEnabled )
-	{
-		oclModel->registerConstant(
-			"REQD_WG_SIZE_FULL_TS",
-			"__attribute__((reqd_work_group_size(" + std::to_string( this->ulNonCachedWorkgroupSizeX )  + ", " + std::to_string( this->ulNonCachedWorkgroupSizeY )  + ", 1)))"
-		);
-	}
+/*
+ *  Set whether the static data (bed, Manning, weir values) and stored face
+ *  discharges are held in single precision while the cell states stay double
+ */
+void	CSchemeGodunov::setMixedPrecision( bool bMixedPrecision )
+{
+	this->bMixedPrecision = bMixedPrecision;
+}
 
-	oclModel->registerConstant(
-		"REQD_WG_SIZE_LINE",
-		"__attribute__((reqd_work_group_size(" + std::to_string( this->ulReductionWorkgroupSize )  + ", 1, 1)))"
-	);
+/*
+ *  Get whether the static data is held in single precision
+ */
+bool	CSchemeGodunov::getMixedPrecision()
+{
+	return this->bMixedPrecision;
+}
 
-	// --
-	// Size of local cache arrays
-	// --
+/*
+ *  Is the static data actually held in single precision? Only meaningful
+ *  when the model itself runs in double precision.
+ */
+bool	CSchemeGodunov::isMixedPrecisionEnabled()
+{
+	return this->bMixedPrecision &&
+		   cModel->getFloatPrecision() == model::floatPrecision::kDouble;
+}
 
-	switch( this->ucCacheConstraints )
-	{
-	case model::cacheConstraints::godunovType::kCacheActualSize:
-			oclModel->registerConstant( "GTS_DIM1", std::to_string( this->ulCachedWorkgroupSizeX ) );
-			oclModel->registerConstant( "GTS_DIM2", std::to_string( this->ulCachedWorkgroupSizeY ) );
-		break;
-	case model::cacheConstraints::godunovType::kCacheAllowUndersize:
-			oclModel->registerConstant( "GTS_DIM1", std::to_string( this->ulCachedWorkgroupSizeX ) );
-			oclModel->registerConstant( "GTS_DIM2", std::to_string( this->ulCachedWorkgroupSizeY ) );
-		break;
-	case model::cacheConstraints::godunovType::kCacheAllowOversize:
-			oclModel->registerConstant( "GTS_DIM1", std::to_string( this->ulCachedWorkgroupSizeX ) );
-			oclModel->registerConstant( "GTS_DIM2", std::to_string( this->ulCachedWorkgroupSizeY == 16 ? 17 : ulCachedWorkgroupSizeY ) );
-		break;
-	}
+/*
+ *  Size of the floats used for the static data and stored face discharges
+ */
+unsigned char	CSchemeGodunov::getStaticFloatSize()
+{
+	if ( this->isMixedPrecisionEnabled() || cModel->getFloatPrecision() != model::floatPrecision::kDouble )
+		return sizeof( cl_float );
+	return sizeof( cl_double );
+}
 
-	// --
-	// CFL/fixed timestep
-	// --
+/*
+ *  Set whether the FSL and max FSL are stored as depths above the bed, which
+ *  keeps the precision of a single-precision state for the water column
+ */
+void	CSchemeGodunov::setDepthEncoding( bool bDepthEncoding )
+{
+	this->bDepthEncoding = bDepthEncoding;
+}
 
-	if ( this->bDynamicTimestep )
-	{
-		oclModel->registerConstant( "TIMESTEP_DYNAMIC",	"1" );
-		oclModel->removeConstant( "TIMESTEP_FIXED" );
+/*
+ *  Get whether the levels are stored as depths
+ */
+bool	CSchemeGodunov::getDepthEncoding()
+{
+	return this->bDepthEncoding;
+}
+
+/*
+ *  Are the levels actually stored as depths? The cached kernels load the
+ *  states directly into LDS rather than through the state accessors.
+ */
+bool	CSchemeGodunov::isDepthEncodingEnabled()
+{
+	return this->bDepthEncoding &&
+		   this->ucConfiguration == model::schemeConfigurations::godunovType::kCacheNone &&
+		   !this->isDoubleFloatEnabled();
+}
+
+/*
+ *  Is the level update emulated as double-float? The low-order part of each
+ *  level is carried between iterations, which only the non-cached kernel does.
+ */
+bool	CSchemeGodunov::isDoubleFloatEnabled()
+{
+	return cModel->getFloatPrecision() == model::floatPrecision::kDoubleFloat &&
+		   this->ucConfiguration == model::schemeConfigurations::godunovType::kCacheNone;
+}
+
+/*
+ *  Set the height of the strips the cells are tiled in (zero for row-major),
+ *  which brings north and south neighbours into the same cache lines
+ */
+void	CSchemeGodunov::setCellTileRows( unsigned int uiCellTileRows )
+{
+	this->uiCellTileRows = uiCellTileRows;
+}
+
+/*
+ *  Get the height of the strips the cells are tiled in
+ */
+unsigned int	CSchemeGodunov::getCellTileRows()
+{
+	return this->uiCellTileRows;
+}
+
+/*
+ *  Are the cells actually tiled? The domain links copy contiguous rows.
+ */
+bool	CSchemeGodunov::isCellTilingEnabled()
+{
+	return this->uiCellTileRows > 1 &&
+		   cModel->getDomainSet()->getDomainCount() <= 1;
+}
+
+/*
+ *  Set the number of fixed timesteps each flux kernel launch advances the
+ *  cells by, working in a local memory tile with a halo of that many cells
+ */
+void	CSchemeGodunov::setTemporalBlockSteps( unsigned int uiTemporalBlockSteps )
+{
+	this->uiTemporalBlockSteps = uiTemporalBlockSteps;
+}
+
+/*
+ *  Get the number of timesteps each flux kernel launch advances the cells by
+ */
+unsigned int	CSchemeGodunov::getTemporalBlockSteps()
+{
+	return this->uiTemporalBlockSteps;
+}
+
+/*
+ *  Does the flux kernel advance several timesteps? The Godunov-type kernels
+ *  have no temporally blocked variant.
+ */
+bool	CSchemeGodunov::isTemporalBlockingEnabled()
+{
+	return false;
+}
+
+/*
+ *  Could the flux kernel advance several timesteps? Only with a fixed
+ *  timestep, the boundary rates applied by the flux kernel itself, launches
+ *  over the whole domain, and room for the halo inside the work-group.
+ */
+bool	CSchemeGodunov::isTemporalBlockingPossible()
+{
+	return this->uiTemporalBlockSteps > 1 &&
+		   !this->bDynamicTimestep &&
+		   this->isBoundaryFused() &&
+		   !this->isActiveTilesEnabled() &&
+		   !this->isWetExtentEnabled() &&
+		   !this->isDoubleFloatEnabled() &&
+		   this->ulNonCachedWorkgroupSizeX > 2 * this->uiTemporalBlockSteps &&
+		   this->ulNonCachedWorkgroupSizeY > 2 * this->uiTemporalBlockSteps;
+}
+
+/*
+ *  Set the number of cells each work-item of the non-cached flux kernel
+ *  walks up, keeping the rows below and above in registers (one for none)
+ */
+void	CSchemeGodunov::setStripCells( unsigned int uiStripCells )
+{
+	this->uiStripCells = uiStripCells;
+}
+
+/*
+ *  Get the number of cells each flux work-item walks up
+ */
+unsigned int	CSchemeGodunov::getStripCells()
+{
+	return this->uiStripCells;
+}
+
+/*
+ *  Does each flux work-item walk up a strip of cells?
+ */
+bool	CSchemeGodunov::isStripMiningEnabled()
+{
+	return this->ucConfiguration == model::schemeConfigurations::godunovType::kCacheNone &&
+		   this->isStripMiningPossible();
+}
+
+/*
+ *  Could each flux work-item walk up a strip of cells? Only when the flux
+ *  kernel is launched over the whole domain, one timestep at a time.
+ */
+bool	CSchemeGodunov::isStripMiningPossible()
+{
+	return this->uiStripCells > 1 &&
+		   !this->isActiveTilesEnabled() &&
+		   !this->isWetExtentEnabled() &&
+		   !this->isTemporalBlockingEnabled() &&
+		   !this->isPersistentLoopEnabled();
+}
+
+/*
+ *  Set whether the non-cached flux kernel reads the bed elevations and
+ *  Manning values as 2D images, through the texture cache
+ */
+void	CSchemeGodunov::setStaticImages( bool bStaticImages )
+{
+	this->bStaticImages = bStaticImages;
+}
+
+/*
+ *  Get whether the bed elevations and Manning values are read as images
+ */
+bool	CSchemeGodunov::getStaticImages()
+{
+	return this->bStaticImages;
+}
+
+/*
+ *  Are the bed elevations and Manning values actually read as images?
+ */
+bool	CSchemeGodunov::isStaticImagesEnabled()
+{
+	return this->ucConfiguration == model::schemeConfigurations::godunovType::kCacheNone &&
+		   this->isStaticImagesPossible();
+}
+
+/*
+ *  Could the bed elevations and Manning values be read as images? Pixels are
+ *  addressed by cell indices, so the host data must be in row-major order,
+ *  and the device must support images as large as the domain.
+ */
+bool	CSchemeGodunov::isStaticImagesPossible()
+{
+	return this->bStaticImages &&
+		   !this->isCellTilingEnabled() &&
+		   !this->isTemporalBlockingEnabled() &&
+		   !this->isPersistentLoopEnabled() &&
+		   cModel->getExecutor()->getDevice()->isImage2DSupported( pDomain->getCols(), pDomain->getRows() );
+}
+
+/*
+ *  Does the non-cached flux kernel read the Manning values as an image too?
+ */
+bool	CSchemeGodunov::isManningImageEnabled()
+{
+	return this->isStaticImagesEnabled();
+}
+
+/*
+ *  Get the bed elevations the non-cached flux kernel reads
+ */
+COCLBuffer*	CSchemeGodunov::getStaticBedBuffer()
+{
+	if ( this->oclBufferCellBedImage != NULL )
+		return oclBufferCellBedImage;
+	return oclBufferCellBed;
+}
+
+/*
+ *  Get the Manning values the non-cached flux kernel reads
+ */
+COCLBuffer*	CSchemeGodunov::getStaticManningBuffer()
+{
+	if ( this->oclBufferCellManningImage != NULL )
+		return oclBufferCellManningImage;
+	return oclBufferCellManning;
+}
+
+/*
+ *  Do iterations with a zero timestep return without copying the cells? The
+ *  host must then know how many were skipped in each batch to keep track of
+ *  which buffer holds the states, so this is only for the non-cached flux
+ *  kernel, one iteration per launch, with nothing else reading the states in
+ *  between batches and no timesteps forced on the domain from outside.
+ */
+bool	CSchemeGodunov::isZeroTimestepSkipEnabled()
+{
+	return this->ucConfiguration == model::schemeConfigurations::godunovType::kCacheNone &&
+		   !this->isActiveTilesEnabled() &&
+		   !this->isWetExtentEnabled() &&
+		   !this->isTemporalBlockingEnabled() &&
+		   !this->isPersistentLoopEnabled() &&
+		   cModel->getDomainSet()->getSyncMethod() != model::syncMethod::kSyncTimestep;
+}
+
+/*
+ *  Number of timesteps advanced by each scheduled iteration
+ */
+unsigned int	CSchemeGodunov::getStepsPerIteration()
+{
+	return this->isTemporalBlockingEnabled() ? this->uiTemporalBlockSteps : 1;
+}
+
+/*
+ *  Set whether each batch of iterations runs from a single launch, with the
+ *  time advanced on the device between iterations
+ */
+void	CSchemeGodunov::setPersistentLoop( bool bPersistentLoop )
+{
+	this->bPersistentLoop = bPersistentLoop;
+}
+
+/*
+ *  Get whether each batch of iterations runs from a single launch
+ */
+bool	CSchemeGodunov::getPersistentLoop()
+{
+	return this->bPersistentLoop;
+}
+
+/*
+ *  Does each batch run from a single launch? The Godunov-type kernels have
+ *  no persistent variant.
+ */
+bool	CSchemeGodunov::isPersistentLoopEnabled()
+{
+	return false;
+}
+
+/*
+ *  Could each batch run from a single launch? The boundary rates and friction
+ *  must be applied by the cell update itself, and the launch always covers
+ *  the whole domain.
+ */
+bool	CSchemeGodunov::isPersistentLoopPossible()
+{
+	return this->bPersistentLoop &&
+		   this->isBoundaryFused() &&
+		   !this->isActiveTilesEnabled() &&
+		   !this->isWetExtentEnabled() &&
+		   !this->isTemporalBlockingEnabled();
+}
+
+/*
+ *  Set whether each work-group commits its fastest cell speed to a single
+ *  slot with an atomic max, in place of one entry per work-group scanned
+ *  serially when the time is advanced
+ */
+void	CSchemeGodunov::setAtomicReduction( bool bAtomicReduction )
+{
+	this->bAtomicReduction = bAtomicReduction;
+}
+
+/*
+ *  Get whether the timestep reduction ends in an atomic max
+ */
+bool	CSchemeGodunov::getAtomicReduction()
+{
+	return this->bAtomicReduction;
+}
+
+/*
+ *  Does the timestep reduction end in an atomic max? Double precision speeds
+ *  need the 64-bit atomics extension.
+ */
+bool	CSchemeGodunov::isAtomicReductionEnabled()
+{
+	return this->bAtomicReduction &&
+		   this->bDynamicTimestep &&
+		   ( !this->isAtomicReduction64() ||
+		     pDomain->getDevice()->isExtensionSupported( "cl_khr_int64_extended_atomics" ) );
+}
+
+/*
+ *  Are the speeds in the reduction 64-bit? Only where the device is actually
+ *  building in double precision.
+ */
+bool	CSchemeGodunov::isAtomicReduction64()
+{
+	return cModel->getFloatPrecision() == model::floatPrecision::kDouble &&
+		   pDomain->getDevice()->isDoubleCompatible();
+}
+
+/*
+ *  Are the work-groups reduced with sub-group built-ins before the atomic?
+ *  Requires the extension and a device that can build OpenCL C 2.0.
+ */
+bool	CSchemeGodunov::isSubgroupReductionEnabled()
+{
+	return this->isAtomicReductionEnabled() &&
+		   pDomain->getDevice()->isExtensionSupported( "cl_khr_subgroups" ) &&
+		   std::strstr( pDomain->getDevice()->getOCLCVersion(), "OpenCL C 1." ) == NULL;
+}
+
+/*
+ *  Describe the timestep reduction for the log
+ */
+std::string	CSchemeGodunov::getReductionDescription()
+{
+	if ( this->isSubgroupReductionEnabled() )
+		return "Atomic (sub-groups)";
+	if ( this->isAtomicReductionEnabled() )
+		return "Atomic";
+	return toStringExact( this->uiTimestepReductionWavefronts ) + " divisions";
+}
+
+/*
+ *  Set whether the device queue may execute commands out of order, leaving
+ *  the barriers to order them. Only commands queued between two barriers may
+ *  then overlap, e.g. the packed floodplains' update with this domain's.
+ */
+void	CSchemeGodunov::setOutOfOrderQueue( bool bOutOfOrderQueue )
+{
+	this->bOutOfOrderQueue = bOutOfOrderQueue;
+}
+
+/*
+ *  Get whether the device queue executes out of order
+ */
+bool	CSchemeGodunov::getOutOfOrderQueue()
+{
+	return this->bOutOfOrderQueue;
+}
+
+/*
+ *  Recreate the device queue in the requested mode before any commands are
+ *  queued. Kernels and buffers fetch the queue from the device as they go.
+ *  The queue is shared, so every scheme on a device must ask for one mode.
+ */
+bool	CSchemeGodunov::prepareCommandQueue()
+{
+	COCLDevice*		pDevice		= this->pDomain->getDevice();
+
+	if ( !pDevice->setOutOfOrderQueue( this->bOutOfOrderQueue, this ) )
+	{
+		model::doError(
+			"Schemes on the same device must use the same command queue mode. Cannot continue.",
+			model::errorCodes::kLevelModelStop
+		);
+		return false;
+	}
+
+	if ( pDevice->isOutOfOrderQueue() != this->bOutOfOrderQueue )
+		model::doError( "Out-of-order command queues are not supported by this device.", model::errorCodes::kLevelWarning );
+
+	return true;
+}
+
+/*
+ *  Set whether the non-cached work-group size and reduction divisions are
+ *  tuned by timing candidates on the device, with the winner cached on disk
+ */
+void	CSchemeGodunov::setAutotune( bool bAutotune )
+{
+	this->bAutotune = bAutotune;
+}
+
+/*
+ *  Get whether the execution dimensions are tuned
+ */
+bool	CSchemeGodunov::getAutotune()
+{
+	return this->bAutotune;
+}
+
+/*
+ *  Set the file holding the tuned execution dimensions
+ */
+void	CSchemeGodunov::setAutotuneCache( std::string sAutotuneCache )
+{
+	this->sAutotuneCache = sAutotuneCache;
+}
+
+/*
+ *  Get the file holding the tuned execution dimensions
+ */
+std::string	CSchemeGodunov::getAutotuneCache()
+{
+	return this->sAutotuneCache;
+}
+
+/*
+ *  Are the execution dimensions actually tuned? The cached kernels size their
+ *  LDS arrays from the work-group, so only the non-cached kernel is tuned.
+ */
+bool	CSchemeGodunov::isAutotuneEnabled()
+{
+	return this->bAutotune &&
+		   this->ucConfiguration == model::schemeConfigurations::godunovType::kCacheNone;
+}
+
+/*
+ *  Scheme name used in the tuning cache key
+ */
+std::string	CSchemeGodunov::getAutotuneScheme()
+{
+	return "Godunov";
+}
+
+/*
+ *  Key identifying this device, driver and scheme build in the tuning cache,
+ *  including every setting that changes the compiled kernels
+ */
+std::string	CSchemeGodunov::getAutotuneKey()
+{
+	COCLDevice*		pDevice		= cModel->getExecutor()->getDevice();
+
+	return std::string( pDevice->clDeviceName ) + "|" +
+		   std::string( pDevice->clDeviceOpenCLDriver ) + "|" +
+		   this->getAutotuneScheme() + "|" +
+		   toStringExact( cModel->getFloatPrecision() ) + "|" +
+		   toStringExact( this->ucConfiguration ) +
+		   (std::string)( this->bUseOptimizedBoundary ? "|O" : "" ) +
+		   (std::string)( this->isReductionFused() ? "|FR" : "" ) +
+		   (std::string)( this->isBoundaryFused() ? "|FB" : "" ) +
+		   (std::string)( this->isActiveTilesEnabled() ? "|AT" : "" ) +
+		   (std::string)( this->isWetExtentEnabled() ? "|WE" : "" ) +
+		   (std::string)( this->isZeroTimestepSkipEnabled() ? "|Z" : "" ) +
+		   (std::string)( this->isStripMiningEnabled() ? "|S" + toStringExact( this->uiStripCells ) : "" ) +
+		   (std::string)( this->isStaticImagesEnabled() ? ( this->isManningImageEnabled() ? "|IM" : "|I" ) : "" ) +
+		   (std::string)( this->isCellStateSoAEnabled() ? "|V" : "" ) +
+		   (std::string)( this->isMixedPrecisionEnabled() ? "|M" : "" ) +
+		   (std::string)( this->isDepthEncodingEnabled() ? "|D" : "" ) +
+		   (std::string)( this->isCellTilingEnabled() ? "|R" + toStringExact( this->uiCellTileRows ) : "" ) +
+		   (std::string)( this->isTemporalBlockingEnabled() ? "|T" + toStringExact( this->uiTemporalBlockSteps ) : "" ) +
+		   (std::string)( this->isAtomicReductionEnabled() ? "|A" : "" ) +
+		   (std::string)( this->isSubgroupReductionEnabled() ? "|G" : "" );
+}
+
+/*
+ *  Load the tuned execution dimensions for this device and scheme, one
+ *  tab-separated entry per line: key, work-group X, work-group Y, divisions
+ */
+bool	CSchemeGodunov::readAutotuneCache()
+{
+	std::ifstream	ifsCache( this->sAutotuneCache.c_str() );
+	std::string		sKey		= this->getAutotuneKey();
+	std::string		sLine;
+
+	if ( !ifsCache.good() )
+		return false;
+
+	while ( std::getline( ifsCache, sLine ) )
+	{
+		std::istringstream	issLine( sLine );
+		std::string			sEntryKey;
+		unsigned long		ulSizeX = 0, ulSizeY = 0;
+		unsigned int		uiWavefronts = 0;
+
+		if ( !std::getline( issLine, sEntryKey, '\t' ) || sEntryKey != sKey )
+			continue;
+		if ( !( issLine >> ulSizeX >> ulSizeY >> uiWavefronts ) || ulSizeX == 0 || ulSizeY == 0 || uiWavefronts == 0 )
+			continue;
+
+		this->ulNonCachedWorkgroupSizeX		= ulSizeX;
+		this->ulNonCachedWorkgroupSizeY		= ulSizeY;
+		this->uiTimestepReductionWavefronts	= uiWavefronts;
+		return true;
+	}
+
+	return false;
+}
+
+/*
+ *  Store the tuned execution dimensions, replacing any earlier entry for
+ *  this device and scheme
+ */
+void	CSchemeGodunov::writeAutotuneCache()
+{
+	std::ifstream				ifsCache( this->sAutotuneCache.c_str() );
+	std::vector<std::string>	sLines;
+	std::string					sKey	= this->getAutotuneKey();
+	std::string					sLine;
+
+	while ( ifsCache.good() && std::getline( ifsCache, sLine ) )
+	{
+		if ( sLine.compare( 0, sKey.length() + 1, sKey + "\t" ) != 0 )
+			sLines.push_back( sLine );
+	}
+	ifsCache.close();
+
+	std::ofstream	ofsCache( this->sAutotuneCache.c_str(), std::ofstream::trunc );
+	if ( !ofsCache.good() )
+	{
+		model::doError( "Could not write the work-group tuning cache.", model::errorCodes::kLevelWarning );
+		return;
+	}
+
+	for ( unsigned int i = 0; i < sLines.size(); ++i )
+		ofsCache << sLines[ i ] << std::endl;
+	ofsCache << sKey << "\t" << this->ulNonCachedWorkgroupSizeX << "\t" << this->ulNonCachedWorkgroupSizeY << "\t" << this->uiTimestepReductionWavefronts << std::endl;
+
+	ofsCache.close();
+}
+
+/*
+ *  Build the scheme with the current execution dimensions and time a short
+ *  run of iterations, returning milliseconds or a negative value on failure
+ */
+double	CSchemeGodunov::timeAutotuneCandidate()
+{
+	const unsigned int	uiIterations	= 20;
+	COCLDevice*			pDevice			= pDomain->getDevice();
+
+	// The domain data is already loaded on the host, so each build gets a copy
+	this->prepareAll();
+	if ( this->oclKernelFullTimestep == NULL )
+		return -1.0;
+
+	this->prepareSimulation();
+
+	// Nothing is allowed to stall on the sync point while timing
+	if ( cModel->getFloatPrecision() != model::floatPrecision::kDouble )
+	{
+		*( oclBufferTimeTarget->getHostBlock<float*>() ) = static_cast<cl_float>( 1E30 );
+	} else {
+		*( oclBufferTimeTarget->getHostBlock<double*>() ) = 1E30;
+	}
+	oclBufferTimeTarget->queueWriteAll();
+	pDevice->queueBarrier();
+
+	// First iteration includes any lazy work by the driver
+	this->scheduleIteration( false, pDevice, pDomain );
+	pDevice->blockUntilFinished();
+
+	CBenchmark*	pBenchmark = new CBenchmark( true );
+	for ( unsigned int i = 0; i < uiIterations; i++ )
+		this->scheduleIteration( ( i % 2 ) == 0, pDevice, pDomain );
+	pDevice->blockUntilFinished();
+	pBenchmark->finish();
+
+	double dMilliseconds = pBenchmark->getMetrics()->dMilliseconds;
+	delete pBenchmark;
+
+	return dMilliseconds;
+}
+
+/*
+ *  Time candidate work-group shapes and then reduction divisions on the
+ *  loaded domain, store the fastest and rebuild with it. Returns true when
+ *  the scheme has been rebuilt and the domain data needs uploading again.
+ */
+bool	CSchemeGodunov::autotuneExecDimensions()
+{
+	if ( this->bAutotuning || !this->isAutotuneEnabled() || this->bAutotuneCached )
+		return false;
+
+	const cl_ulong		ulShapes[][2]		= { { 8, 8 }, { 16, 8 }, { 8, 16 }, { 16, 16 }, { 32, 4 }, { 32, 8 }, { 64, 4 }, { 32, 16 } };
+	const unsigned int	uiWavefronts[]		= { 50, 100, 200, 400, 800 };
+	COCLDevice*			pDevice				= pDomain->getDevice();
+	unsigned int		uiActiveTilesInterval = this->uiActiveTilesInterval;
+	cl_ulong			ulBestX				= this->ulNonCachedWorkgroupSizeX;
+	cl_ulong			ulBestY				= this->ulNonCachedWorkgroupSizeY;
+	unsigned int		uiBestWavefronts	= this->uiTimestepReductionWavefronts;
+	double				dBestTime			= -1.0;
+
+	model::log->writeLine( "Tuning work-group sizes for this device and scheme..." );
+	this->bAutotuning = true;
+
+	for ( unsigned int i = 0; i < sizeof( ulShapes ) / sizeof( ulShapes[0] ); ++i )
+	{
+		if ( ulShapes[i][0] * ulShapes[i][1] > pDevice->clDeviceMaxWorkGroupSize ||
+			 ulShapes[i][0] > pDevice->clDeviceMaxWorkItemSizes[0] ||
+			 ulShapes[i][1] > pDevice->clDeviceMaxWorkItemSizes[1] )
+			continue;
+
+		this->ulNonCachedWorkgroupSizeX		= ulShapes[i][0];
+		this->ulNonCachedWorkgroupSizeY		= ulShapes[i][1];
+		this->uiActiveTilesInterval			= uiActiveTilesInterval;
+
+		double dTime = this->timeAutotuneCandidate();
+		if ( dTime >= 0.0 && ( dBestTime < 0.0 || dTime < dBestTime ) )
+		{
+			dBestTime	= dTime;
+			ulBestX		= ulShapes[i][0];
+			ulBestY		= ulShapes[i][1];
+		}
+	}
+
+	// The atomic reduction is sized from the device alone, so has no divisions to tune
+	dBestTime = -1.0;
+	for ( unsigned int i = 0; i < sizeof( uiWavefronts ) / sizeof( uiWavefronts[0] ) && !this->isAtomicReductionEnabled(); ++i )
+	{
+		this->ulNonCachedWorkgroupSizeX		= ulBestX;
+		this->ulNonCachedWorkgroupSizeY		= ulBestY;
+		this->uiTimestepReductionWavefronts	= uiWavefronts[i];
+		this->uiActiveTilesInterval			= uiActiveTilesInterval;
+
+		double dTime = this->timeAutotuneCandidate();
+		if ( dTime >= 0.0 && ( dBestTime < 0.0 || dTime < dBestTime ) )
+		{
+			dBestTime			= dTime;
+			uiBestWavefronts	= uiWavefronts[i];
+		}
+	}
+
+	this->bAutotuning					= false;
+	this->bAutotuneCached				= true;
+	this->ulNonCachedWorkgroupSizeX		= ulBestX;
+	this->ulNonCachedWorkgroupSizeY		= ulBestY;
+	this->uiTimestepReductionWavefronts	= uiBestWavefronts;
+	this->uiActiveTilesInterval			= uiActiveTilesInterval;
+
+	model::log->writeLine( "Tuned work-group size is " + toStringExact( ulBestX ) + "x" + toStringExact( ulBestY ) + ( this->isAtomicReductionEnabled() ? "." : " with " + toStringExact( uiBestWavefronts ) + " reduction divisions." ) );
+	this->writeAutotuneCache();
+
+	this->prepareAll();
+	return true;
+}
+
+/*
+ *  Calculate the dimensions for executing the problems (e.g. reduction glob/local sizes)
+ */
+bool CSchemeGodunov::prepare1OExecDimensions()
+{
+	bool						bReturnState = true;
+	CExecutorControlOpenCL*		pExecutor	 = cModel->getExecutor();
+	COCLDevice*		pDevice		 = pExecutor->getDevice();
+	CDomainCartesian*			pDomain		 = static_cast<CDomainCartesian*>( this->pDomain );
+
+	// --
+	// Maximum permissible work-group dimensions for this device
+	// --
+
+	cl_ulong	ulConstraintWGTotal = (cl_ulong)floor( sqrt( static_cast<double> ( pDevice->clDeviceMaxWorkGroupSize ) ) );
+	cl_ulong	ulConstraintWGDim   = min( pDevice->clDeviceMaxWorkItemSizes[0], pDevice->clDeviceMaxWorkItemSizes[1] );
+	cl_ulong	ulConstraintWG		= min( ulConstraintWGDim, ulConstraintWGTotal );
+
+	// --
+	// Main scheme kernels with/without caching (2D)
+	// --
+
+	if ( this->ulNonCachedWorkgroupSizeX == 0 )
+		ulNonCachedWorkgroupSizeX = ulConstraintWG;
+	if ( this->ulNonCachedWorkgroupSizeY == 0 )
+		ulNonCachedWorkgroupSizeY = ulConstraintWG;
+
+	ulNonCachedGlobalSizeX	= pDomain->getCols();
+	ulNonCachedGlobalSizeY	= pDomain->getRows();
+
+	if ( this->ulCachedWorkgroupSizeX == 0 )
+		ulCachedWorkgroupSizeX = ulConstraintWG +
+							 ( this->ucCacheConstraints == model::cacheConstraints::musclHancock::kCacheAllowUndersize ? -1 : 0 );
+	if ( this->ulCachedWorkgroupSizeY == 0 )
+		ulCachedWorkgroupSizeY = ulConstraintWG;
+
+	// Tuned sizes from an earlier run on this device replace the configured ones
+	if ( this->isAutotuneEnabled() && !this->bAutotuning && !this->bAutotuneCached )
+		this->bAutotuneCached = this->readAutotuneCache();
+
+	ulCachedGlobalSizeX	= static_cast<unsigned long>( ceil( pDomain->getCols() * 
+						  ( this->ucConfiguration == model::schemeConfigurations::godunovType::kCacheEnabled ? static_cast<double>( ulCachedWorkgroupSizeX ) / static_cast<double>( ulCachedWorkgroupSizeX - 2 ) : 1.0 ) ) );
+	ulCachedGlobalSizeY	= static_cast<unsigned long>( ceil( pDomain->getRows() * 
+						  ( this->ucConfiguration == model::schemeConfigurations::godunovType::kCacheEnabled ? static_cast<double>( ulCachedWorkgroupSizeY ) / static_cast<double>( ulCachedWorkgroupSizeY - 2 ) : 1.0 ) ) );
+
+	// --
+	// Temporally blocked flux kernel (work-groups overlap by the halo)
+	// --
+
+	ulTemporalBlockGlobalSizeX	= static_cast<cl_ulong>( ceil( static_cast<double>( ulNonCachedGlobalSizeX ) / max( static_cast<cl_ulong>( 1 ), static_cast<cl_ulong>( ulNonCachedWorkgroupSizeX - 2 * min( static_cast<cl_ulong>( this->uiTemporalBlockSteps ), ulNonCachedWorkgroupSizeX / 2 ) ) ) ) ) * ulNonCachedWorkgroupSizeX;
+	ulTemporalBlockGlobalSizeY	= static_cast<cl_ulong>( ceil( static_cast<double>( ulNonCachedGlobalSizeY ) / max( static_cast<cl_ulong>( 1 ), static_cast<cl_ulong>( ulNonCachedWorkgroupSizeY - 2 * min( static_cast<cl_ulong>( this->uiTemporalBlockSteps ), ulNonCachedWorkgroupSizeY / 2 ) ) ) ) ) * ulNonCachedWorkgroupSizeY;
+
+	if ( this->uiTemporalBlockSteps > 1 && !this->isTemporalBlockingEnabled() && !this->bAutotuning )
+		model::doError( "Temporal blocking is not available with these settings.", model::errorCodes::kLevelWarning );
+
+	// --
+	// Strip-mined flux kernel (each work-item walks up several rows)
+	// --
+
+	ulStripGlobalSizeY	= static_cast<cl_ulong>( ceil( static_cast<double>( ulNonCachedGlobalSizeY ) / max( static_cast<unsigned int>( 1 ), this->uiStripCells ) ) );
+
+	if ( this->uiStripCells > 1 && !this->isStripMiningEnabled() && !this->bAutotuning )
+		model::doError( "Strip mining is not available with these settings.", model::errorCodes::kLevelWarning );
+
+	// --
+	// Active tiles (one per work-group of the non-cached kernels)
+	// --
+
+	ulActiveTilesX	= static_cast<cl_ulong>( ceil( static_cast<double>( ulNonCachedGlobalSizeX ) / ulNonCachedWorkgroupSizeX ) );
+	ulActiveTilesY	= static_cast<cl_ulong>( ceil( static_cast<double>( ulNonCachedGlobalSizeY ) / ulNonCachedWorkgroupSizeY ) );
+
+	// Water moves at most one cell per iteration, so must not cross the ring of tiles around the wet tiles between rebuilds
+	if ( this->uiActiveTilesInterval > min( ulNonCachedWorkgroupSizeX, ulNonCachedWorkgroupSizeY ) )
+	{
+		this->uiActiveTilesInterval = static_cast<unsigned int>( min( ulNonCachedWorkgroupSizeX, ulNonCachedWorkgroupSizeY ) );
+		if ( this->isActiveTilesEnabled() )
+			model::doError( "Active tile rebuild interval reduced to " + toStringExact( this->uiActiveTilesInterval ) + " iteration(s).", model::errorCodes::kLevelWarning );
+	}
+	if ( this->uiActiveTilesInterval < 1 )
+		this->uiActiveTilesInterval = 1;
+
+	// --
+	// Optimized Coupling
+	// --
+	this->bUseOptimizedBoundary	= pDomain->getSummary().bUseOptimizedBoundary;
+	this->ulCouplingArraySize	= pDomain->getSummary().ulCouplingArraySize;
+
+
+	// --
+	// Timestep reduction (2D)
+	// --
+
+	// TODO: May need to make this configurable?!
+	ulReductionWorkgroupSize = min(static_cast<size_t>(512), pDevice->clDeviceMaxWorkGroupSize);
+	//ulReductionWorkgroupSize = pDevice->clDeviceMaxWorkGroupSize / 2;
+	ulReductionGlobalSize = static_cast<unsigned long>( ceil( ( static_cast<double>(pDomain->getCellCount()) / this->uiTimestepReductionWavefronts ) / ulReductionWorkgroupSize ) * ulReductionWorkgroupSize );
+
+	// All work-groups share one slot with the atomic reduction, so enough to fill the device will do
+	if ( this->isAtomicReductionEnabled() )
+	{
+		ulReductionGlobalSize = min( static_cast<cl_ulong>( ceil( static_cast<double>( pDomain->getCellCount() ) / ulReductionWorkgroupSize ) ) * ulReductionWorkgroupSize,
+									 static_cast<cl_ulong>( pDevice->clDeviceComputeUnits ) * ulReductionWorkgroupSize * 4 );
+	}
+
+	// Flux kernel commits one entry per work-group when the reduction is fused
+	else if ( this->isReductionFused() )
+	{
+		cl_ulong ulFluxGroups = static_cast<cl_ulong>( ceil( static_cast<double>( ulNonCachedGlobalSizeX ) / ulNonCachedWorkgroupSizeX ) ) *
+							    static_cast<cl_ulong>( ceil( static_cast<double>( ulNonCachedGlobalSizeY ) / ulNonCachedWorkgroupSizeY ) );
+		ulReductionGlobalSize = max( ulReductionGlobalSize, 
+									 static_cast<cl_ulong>( ceil( static_cast<double>( ulFluxGroups ) / ulReductionWorkgroupSize ) ) * ulReductionWorkgroupSize );
+	}
+
+	return bReturnState;
+}
+
+/*
+ *  Allocate constants using the settings herein
+ */
+bool CSchemeGodunov::prepare1OConstants()
+{
+	CDomainCartesian*	pDomain	= static_cast<CDomainCartesian*>( this->pDomain );
+
+	// --
+	// Dry cell threshold depths
+	// --
+	oclModel->registerConstant( "VERY_SMALL",			toStringExact( this->dThresholdVerySmall ) );
+	oclModel->registerConstant( "QUITE_SMALL",			toStringExact( this->dThresholdQuiteSmall ) );
+
+	// --
+	// Debug mode 
+	// --
+
+	if ( this->bDebugOutput )
+	{
+		oclModel->registerConstant( "DEBUG_OUTPUT",		"1" );
+		oclModel->registerConstant( "DEBUG_CELLX",		std::to_string( this->uiDebugCellX ) );
+		oclModel->registerConstant( "DEBUG_CELLY",		std::to_string( this->uiDebugCellY ) );
+	} else {
+		oclModel->removeConstant( "DEBUG_OUTPUT" );
+		oclModel->removeConstant( "DEBUG_CELLX" );
+		oclModel->removeConstant( "DEBUG_CELLY" );
+	}
+
+	// --
+	// Work-group size requirements
+	// --
+
+	if ( this->ucConfiguration == model::schemeConfigurations::godunovType::kCacheNone )
+	{
+		oclModel->registerConstant(
+			"REQD_WG_SIZE_FULL_TS",
+			"__attribute__((reqd_work_group_size(" + std::to_string( this->ulNonCachedWorkgroupSizeX )  + ", " + std::to_string( this->ulNonCachedWorkgroupSizeY )  + ", 1)))"
+		);
+	}
+	if ( this->ucConfiguration == model::schemeConfigurations::godunovType::kCacheEnabled )
+	{
+		oclModel->registerConstant(
+			"REQD_WG_SIZE_FULL_TS",
+			"__attribute__((reqd_work_group_size(" + std::to_string( this->ulNonCachedWorkgroupSizeX )  + ", " + std::to_string( this->ulNonCachedWorkgroupSizeY )  + ", 1)))"
+		);
+	}
+
+	oclModel->registerConstant(
+		"REQD_WG_SIZE_LINE",
+		"__attribute__((reqd_work_group_size(" + std::to_string( this->ulReductionWorkgroupSize )  + ", 1, 1)))"
+	);
+
+	// --
+	// Size of local cache arrays
+	// --
+
+	switch( this->ucCacheConstraints )
+	{
+	case model::cacheConstraints::godunovType::kCacheActualSize:
+			oclModel->registerConstant( "GTS_DIM1", std::to_string( this->ulCachedWorkgroupSizeX ) );
+			oclModel->registerConstant( "GTS_DIM2", std::to_string( this->ulCachedWorkgroupSizeY ) );
+		break;
+	case model::cacheConstraints::godunovType::kCacheAllowUndersize:
+			oclModel->registerConstant( "GTS_DIM1", std::to_string( this->ulCachedWorkgroupSizeX ) );
+			oclModel->registerConstant( "GTS_DIM2", std::to_string( this->ulCachedWorkgroupSizeY ) );
+		break;
+	case model::cacheConstraints::godunovType::kCacheAllowOversize:
+			oclModel->registerConstant( "GTS_DIM1", std::to_string( this->ulCachedWorkgroupSizeX ) );
+			oclModel->registerConstant( "GTS_DIM2", std::to_string( this->ulCachedWorkgroupSizeY == 16 ? 17 : ulCachedWorkgroupSizeY ) );
+		break;
+	}
+
+	// --
+	// CFL/fixed timestep
+	// --
+
+	if ( this->bDynamicTimestep )
+	{
+		oclModel->registerConstant( "TIMESTEP_DYNAMIC",	"1" );
+		oclModel->removeConstant( "TIMESTEP_FIXED" );
+	} else {
+		oclModel->registerConstant( "TIMESTEP_FIXED",	std::to_string(this->dTimestep) );
+		oclModel->removeConstant( "TIMESTEP_DYNAMIC" );
+	}
+
+	if (this->bFrictionEffects)
+	{
+		oclModel->registerConstant("FRICTION_ENABLED", "1");
+	}
+	else {
+		oclModel->removeConstant("FRICTION_ENABLED");
+	}
+
+	if ( this->bFrictionInFluxKernel )
+	{
+		oclModel->registerConstant( "FRICTION_IN_FLUX_KERNEL",	"1" );
+	}
+
+	// --
+	// Timestep reduction and simulation parameters
+	// --
+	oclModel->registerConstant( "TIMESTEP_WORKERS",		std::to_string( this->ulReductionGlobalSize ) );
+	oclModel->registerConstant( "TIMESTEP_GROUPSIZE",	std::to_string( this->ulReductionWorkgroupSize ) );
+	if ( this->isReductionFused() )
+	{
+		oclModel->registerConstant( "TIMESTEP_IN_FLUX_KERNEL",	"1" );
+		oclModel->registerConstant( "TIMESTEP_FLUX_GROUPSIZE",	std::to_string( this->ulNonCachedWorkgroupSizeX * this->ulNonCachedWorkgroupSizeY ) );
+	} else {
+		oclModel->removeConstant( "TIMESTEP_IN_FLUX_KERNEL" );
+		oclModel->removeConstant( "TIMESTEP_FLUX_GROUPSIZE" );
+	}
+	if ( this->isAtomicReductionEnabled() )
+	{
+		oclModel->registerConstant( "TIMESTEP_ATOMIC",		"1" );
+	} else {
+		oclModel->removeConstant( "TIMESTEP_ATOMIC" );
+		if ( this->bAtomicReduction && this->bDynamicTimestep )
+			model::doError( "The atomic timestep reduction is not available on this device.", model::errorCodes::kLevelWarning );
+	}
+	if ( this->isAtomicReductionEnabled() && this->isAtomicReduction64() )
+	{
+		oclModel->registerConstant( "TIMESTEP_ATOMIC_64",	"1" );
+	} else {
+		oclModel->removeConstant( "TIMESTEP_ATOMIC_64" );
+	}
+	if ( this->isSubgroupReductionEnabled() )
+	{
+		oclModel->registerConstant( "TIMESTEP_SUBGROUPS",	"1" );
+	} else {
+		oclModel->removeConstant( "TIMESTEP_SUBGROUPS" );
+	}
+	oclModel->registerConstant( "SCHEME_ENDTIME",		std::to_string( cModel->getSimulationLength() ) );
+	oclModel->registerConstant( "SCHEME_OUTPUTTIME",	std::to_string( cModel->getOutputFrequency() ) );
+	oclModel->registerConstant( "COURANT_NUMBER",		std::to_string( this->dCourantNumber ) );
+
+	// --
+	// Domain details (size, resolution, etc.)
+	// --
+
+	double	dResolutionX, dResolutionY;
+	pDomain->getCellResolution( &dResolutionX, &dResolutionY);
+
+	unsigned long ulOptimizedCouplingArraySize = pDomain->getSummary().ulCouplingArraySize;
+
+	oclModel->registerConstant( "DOMAIN_CELLCOUNT",		std::to_string( pDomain->getCellCount() ) );
+	oclModel->registerConstant( "DOMAIN_COLS",			std::to_string( pDomain->getCols() ) );
+	oclModel->registerConstant( "DOMAIN_ROWS",			std::to_string( pDomain->getRows() ) );
+	oclModel->registerConstant( "DOMAIN_DELTAX",		std::to_string( dResolutionX ));
+	oclModel->registerConstant( "DOMAIN_DELTAY",		std::to_string( dResolutionY ));
+	oclModel->registerConstant( "COUPLING_ARRAY_SIZE",  std::to_string( ulOptimizedCouplingArraySize ));
+	oclModel->registerConstant( "WEIR_FACE_COUNT",		std::to_string( pDomain->getWeirFaceCapacity() ));
+
+	// --
+	// Temporal blocking
+	// --
+
+	if ( this->isTemporalBlockingEnabled() )
+	{
+		oclModel->registerConstant( "TEMPORAL_BLOCK_STEPS",	std::to_string( this->uiTemporalBlockSteps ) );
+		oclModel->registerConstant( "TBK_DIM1",				std::to_string( this->ulNonCachedWorkgroupSizeX ) );
+		oclModel->registerConstant( "TBK_DIM2",				std::to_string( this->ulNonCachedWorkgroupSizeY ) );
+	} else {
+		oclModel->removeConstant( "TEMPORAL_BLOCK_STEPS" );
+		oclModel->removeConstant( "TBK_DIM1" );
+		oclModel->removeConstant( "TBK_DIM2" );
+	}
+
+	// --
+	// Persistent iteration loop (one work-group strides over the domain)
+	// --
+
+	if ( this->isPersistentLoopEnabled() )
+	{
+		oclModel->registerConstant( "PERSISTENT_LOOP",		"1" );
+		oclModel->registerConstant( "PERSISTENT_GROUPSIZE",	std::to_string( this->ulNonCachedWorkgroupSizeX * this->ulNonCachedWorkgroupSizeY ) );
+	} else {
+		oclModel->removeConstant( "PERSISTENT_LOOP" );
+		oclModel->removeConstant( "PERSISTENT_GROUPSIZE" );
+		if ( this->bPersistentLoop && !this->bAutotuning )
+			model::doError( "The persistent iteration loop is not available with these settings.", model::errorCodes::kLevelWarning );
+	}
+
+	// --
+	// Strip-mined flux kernel
+	// --
+
+	if ( this->isStripMiningEnabled() )
+	{
+		oclModel->registerConstant( "STRIP_CELLS",			std::to_string( this->uiStripCells ) );
+	} else {
+		oclModel->removeConstant( "STRIP_CELLS" );
+	}
+
+	// --
+	// Bed elevations and Manning values as images
+	// --
+
+	if ( this->isStaticImagesEnabled() )
+	{
+		oclModel->registerConstant( "STATIC_IMAGES",		"1" );
+		if ( this->getStaticFloatSize() == sizeof( cl_double ) )
+		{
+			oclModel->registerConstant( "STATIC_IMAGES_PACKED", "1" );
+		} else {
+			oclModel->removeConstant( "STATIC_IMAGES_PACKED" );
+		}
+	} else {
+		oclModel->removeConstant( "STATIC_IMAGES" );
+		oclModel->removeConstant( "STATIC_IMAGES_PACKED" );
+		if ( this->bStaticImages && !this->bAutotuning )
+			model::doError( "Image storage for the bed and Manning values is not available with these settings.", model::errorCodes::kLevelWarning );
+	}
+
+	// --
+	// Iterations with a zero timestep
+	// --
+
+	if ( this->isZeroTimestepSkipEnabled() )
+	{
+		oclModel->registerConstant( "ZERO_TIMESTEP_SKIP",	"1" );
+	} else {
+		oclModel->removeConstant( "ZERO_TIMESTEP_SKIP" );
+	}
+
+	// Host and device must agree on what each cell ID refers to
+	pDomain->setCellTileRows( this->isCellTilingEnabled() ? this->uiCellTileRows : 0 );
+	if ( this->isCellTilingEnabled() )
+	{
+		oclModel->registerConstant( "DOMAIN_TILE_ROWS",	std::to_string( this->uiCellTileRows ) );
+	} else {
+		oclModel->removeConstant( "DOMAIN_TILE_ROWS" );
+	}
+
+	// --
+	// Active tiles
+	// --
+
+	if ( this->isActiveTilesEnabled() )
+	{
+		oclModel->registerConstant( "ACTIVE_TILES",			"1" );
+		oclModel->registerConstant( "ACTIVE_TILES_X",		std::to_string( this->ulActiveTilesX ) );
+		oclModel->registerConstant( "ACTIVE_TILES_Y",		std::to_string( this->ulActiveTilesY ) );
+		oclModel->registerConstant( "ACTIVE_TILE_SIZE_X",	std::to_string( this->ulNonCachedWorkgroupSizeX ) );
+		oclModel->registerConstant( "ACTIVE_TILE_SIZE_Y",	std::to_string( this->ulNonCachedWorkgroupSizeY ) );
 	} else {
-		oclModel->registerConstant( "TIMESTEP_FIXED",	std::to_string(this->dTimestep) );
-		oclModel->removeConstant( "TIMESTEP_DYNAMIC" );
+		oclModel->removeConstant( "ACTIVE_TILES" );
+		oclModel->removeConstant( "ACTIVE_TILES_X" );
+		oclModel->removeConstant( "ACTIVE_TILES_Y" );
+		oclModel->removeConstant( "ACTIVE_TILE_SIZE_X" );
+		oclModel->removeConstant( "ACTIVE_TILE_SIZE_Y" );
 	}
 
-	if (this->bFrictionEffects)
+	if ( this->isWetExtentEnabled() )
 	{
-		oclModel->registerConstant("FRICTION_ENABLED", "1");
+		oclModel->registerConstant( "WET_EXTENT",			"1" );
+	} else {
+		oclModel->removeConstant( "WET_EXTENT" );
 	}
-	else {
-		oclModel->removeConstant("FRICTION_ENABLED");
+
+	if ( this->isCellStateSoAEnabled() )
+	{
+		oclModel->registerConstant( "CELL_STATE_SOA",		"1" );
+	} else {
+		oclModel->removeConstant( "CELL_STATE_SOA" );
 	}
 
-	if ( this->bFrictionInFluxKernel )
+	if ( this->isMixedPrecisionEnabled() )
 	{
-		oclModel->registerConstant( "FRICTION_IN_FLUX_KERNEL",	"1" );
+		oclModel->registerConstant( "MIXED_PRECISION",		"1" );
+	} else {
+		oclModel->removeConstant( "MIXED_PRECISION" );
 	}
 
-	// --
-	// Timestep reduction and simulation parameters
-	// --
-	oclModel->registerConstant( "TIMESTEP_WORKERS",		std::to_string( this->ulReductionGlobalSize ) );
-	oclModel->registerConstant( "TIMESTEP_GROUPSIZE",	std::to_string( this->ulReductionWorkgroupSize ) );
-	oclModel->registerConstant( "SCHEME_ENDTIME",		std::to_string( cModel->getSimulationLength() ) );
-	oclModel->registerConstant( "SCHEME_OUTPUTTIME",	std::to_string( cModel->getOutputFrequency() ) );
-	oclModel->registerConstant( "COURANT_NUMBER",		std::to_string( this->dCourantNumber ) );
+	if ( this->isDepthEncodingEnabled() )
+	{
+		oclModel->registerConstant( "DEPTH_ENCODING",		"1" );
+	} else {
+		oclModel->removeConstant( "DEPTH_ENCODING" );
+	}
 
 	// --
-	// Domain details (size, resolution, etc.)
+	// Boundary conditions
 	// --
 
-	double	dResolutionX, dResolutionY;
-	pDomain->getCellResolution( &dResolutionX, &dResolutionY);
-
-	unsigned long ulOptimizedCouplingArraySize = pDomain->getSummary().ulCouplingArraySize;
+	if ( this->bUseOptimizedBoundary )
+	{
+		oclModel->registerConstant( "BOUNDARY_BY_ID",	"1" );
+	} else {
+		oclModel->removeConstant( "BOUNDARY_BY_ID" );
+	}
 
-	oclModel->registerConstant( "DOMAIN_CELLCOUNT",		std::to_string( pDomain->getCellCount() ) );
-	oclModel->registerConstant( "DOMAIN_COLS",			std::to_string( pDomain->getCols() ) );
-	oclModel->registerConstant( "DOMAIN_ROWS",			std::to_string( pDomain->getRows() ) );
-	oclModel->registerConstant( "DOMAIN_DELTAX",		std::to_string( dResolutionX ));
-	oclModel->registerConstant( "DOMAIN_DELTAY",		std::to_string( dResolutionY ));
-	oclModel->registerConstant( "COUPLING_ARRAY_SIZE",  std::to_string( ulOptimizedCouplingArraySize ));
+	if ( this->isBoundaryFused() )
+	{
+		oclModel->registerConstant( "BOUNDARY_IN_FLUX_KERNEL",	"1" );
+	} else {
+		oclModel->removeConstant( "BOUNDARY_IN_FLUX_KERNEL" );
+	}
 
 	return true;
 }
@@ -577,28 +1738,58 @@ bool CSchemeGodunov::prepare1OMemory()
 	CDomain*					pDomain				= this->pDomain;
 	COCLDevice*					pDevice				= pExecutor->getDevice();
 
-	unsigned char ucFloatSize = (cModel->getFloatPrecision() == model::floatPrecision::kSingle ? sizeof(cl_float) : sizeof(cl_double));
+	unsigned char ucFloatSize = (cModel->getFloatPrecision() != model::floatPrecision::kDouble ? sizeof(cl_float) : sizeof(cl_double));
+	unsigned char ucStaticFloatSize = this->getStaticFloatSize();
 
 	// --
-	// Batch tracking data
+	// Batch status block (per-domain scalars read back together)
 	// --
 
-	oclBufferBatchTimesteps	 = new COCLBuffer( "Batch timesteps cumulative", oclModel, false, true, ucFloatSize, true );
-	oclBufferBatchSuccessful = new COCLBuffer( "Batch successful iterations", oclModel, false, true, sizeof(cl_uint), true );
-	oclBufferBatchSkipped	 = new COCLBuffer( "Batch skipped iterations", oclModel, false, true, sizeof(cl_uint), true );
+	// Each scalar is a sub-buffer, so must start on the device's base address alignment
+	cl_ulong	ulStatusStride	= max( static_cast<cl_ulong>( pDevice->clDeviceAlignBits / 8 ), static_cast<cl_ulong>( 4 * sizeof( cl_uint ) ) );
+	this->ulBatchStatusStride	= ulStatusStride;
+
+	// The scheme's own status is read back with the rest, so follows the wet extent
+	cl_ulong	ulStatusExtra	= this->getBatchStatusExtraSize();
+
+	oclBufferBatchStatus		= new COCLBuffer( "Batch status", oclModel, false, true, 9 * ulStatusStride + ulStatusExtra, true );
+	oclBufferTime				= new COCLBuffer( "Time", oclModel, false, true, ucFloatSize, false );
+	oclBufferTimestep			= new COCLBuffer( "Timestep", oclModel, false, true, ucFloatSize, false );
+	oclBufferTimeHydrological	= new COCLBuffer( "Time (hydrological)", oclModel, false, true, ucFloatSize, false );
+	oclBufferBatchTimesteps		= new COCLBuffer( "Batch timesteps cumulative", oclModel, false, true, ucFloatSize, false );
+	oclBufferBatchSuccessful	= new COCLBuffer( "Batch successful iterations", oclModel, false, true, sizeof( cl_uint ), false );
+	oclBufferBatchSkipped		= new COCLBuffer( "Batch skipped iterations", oclModel, false, true, sizeof( cl_uint ), false );
+	oclBufferWetExtent			= new COCLBuffer( "Wet extent", oclModel, false, true, 4 * sizeof( cl_uint ), false );
+	oclBufferTimeTarget			= new COCLBuffer( "Target time (sync)", oclModel, false, true, ucFloatSize, false );
+	oclBufferIterationBudget	= new COCLBuffer( "Iteration budget", oclModel, false, true, sizeof( cl_uint ), false );
+
+	// Only the scalars the device changes during a batch are read back, which come first
+	this->ulBatchStatusExtraOffset	= 7 * ulStatusStride;
+	this->ulBatchStatusReadSize		= ( ulStatusExtra > 0 ? 7 * ulStatusStride + ulStatusExtra : 6 * ulStatusStride + 4 * sizeof( cl_uint ) );
+
+	oclBufferBatchStatus->createBuffer();
+	oclBufferTime->createSubBuffer( oclBufferBatchStatus, 0 * ulStatusStride );
+	oclBufferTimestep->createSubBuffer( oclBufferBatchStatus, 1 * ulStatusStride );
+	oclBufferTimeHydrological->createSubBuffer( oclBufferBatchStatus, 2 * ulStatusStride );
+	oclBufferBatchTimesteps->createSubBuffer( oclBufferBatchStatus, 3 * ulStatusStride );
+	oclBufferBatchSuccessful->createSubBuffer( oclBufferBatchStatus, 4 * ulStatusStride );
+	oclBufferBatchSkipped->createSubBuffer( oclBufferBatchStatus, 5 * ulStatusStride );
+	oclBufferWetExtent->createSubBuffer( oclBufferBatchStatus, 6 * ulStatusStride );
+	oclBufferTimeTarget->createSubBuffer( oclBufferBatchStatus, 7 * ulStatusStride + ulStatusExtra );
+	oclBufferIterationBudget->createSubBuffer( oclBufferBatchStatus, 8 * ulStatusStride + ulStatusExtra );
 
-	if (cModel->getFloatPrecision() == model::floatPrecision::kSingle)
+	// We duplicate the time and timestep variables if we're using single-precision so we have copies in both formats
+	// (the batch counters and remaining scalars start as zero)
+	if (cModel->getFloatPrecision() != model::floatPrecision::kDouble)
 	{
-		*( oclBufferBatchTimesteps->getHostBlock<float*>() )	= 0.0f;
+		*( oclBufferTime->getHostBlock<float*>()     )			= static_cast<cl_float>( this->dCurrentTime );
+		*( oclBufferTimestep->getHostBlock<float*>() )			= static_cast<cl_float>( this->dCurrentTimestep );
 	} else {
-		*( oclBufferBatchTimesteps->getHostBlock<double*>() )	= 0.0;
+		*( oclBufferTime->getHostBlock<double*>()     )			= this->dCurrentTime;
+		*( oclBufferTimestep->getHostBlock<double*>() )			= this->dCurrentTimestep;
 	}
-	*( oclBufferBatchSuccessful->getHostBlock<cl_uint*>() )		= 0;
-	*( oclBufferBatchSkipped->getHostBlock<cl_uint*>() )		= 0;
 
-	oclBufferBatchTimesteps->createBuffer();
-	oclBufferBatchSuccessful->createBuffer();
-	oclBufferBatchSkipped->createBuffer();
+	oclBufferBatchStatus->queueWriteAll();
 
 	// --
 	// Domain and cell state data
@@ -608,11 +1799,9 @@ bool CSchemeGodunov::prepare1OMemory()
 	void* pBedElevations	= NULL;
 	void* pManningValues	= NULL;
 	void* pBoundaryValues	= NULL;
-	void* pPoleniValues		= NULL;
-	void* pOpt_zxmax		= NULL;
-	void* pOpt_cx			= NULL;
-	void* pOpt_zymax		= NULL;
-	void* pOpt_cy			= NULL;
+	void* pPoleniMasks		= NULL;
+	void* pWeirFaceIDs		= NULL;
+	void* pWeirFaceValues	= NULL;
 	void* pCouplingIDs		= NULL;
 	void* pCouplingValues	= NULL;
 
@@ -621,14 +1810,15 @@ bool CSchemeGodunov::prepare1OMemory()
 		&pBedElevations,
 		&pManningValues,
 		&pBoundaryValues,
-		&pPoleniValues,
-		&pOpt_zxmax,
-		&pOpt_cx,
-		&pOpt_zymax,
-		&pOpt_cy,
+		&pPoleniMasks,
+		&pWeirFaceIDs,
+		&pWeirFaceValues,
 		&pCouplingIDs,
 		&pCouplingValues,
-		ucFloatSize
+		ucFloatSize,
+		ucStaticFloatSize,
+		this->isCellStateSoAEnabled(),
+		this->isDepthEncodingEnabled()
 	);
 
 	oclBufferCellStates		= new COCLBuffer( "Cell states",			oclModel, false, true );
@@ -640,16 +1830,14 @@ bool CSchemeGodunov::prepare1OMemory()
 		oclBufferCouplingIDs	= new COCLBuffer( "Coupling IDs",		oclModel, true, true );
 		oclBufferCouplingValues = new COCLBuffer( "Coupling Values",		oclModel, false, true );
 	}
-	oclBufferUsePoleni		= new COCLBuffer( "Poleni Booleans",			oclModel, true,	 true );
-	oclBuffer_opt_zxmax		= new COCLBuffer( "opt_zxmax Values",		oclModel, true,	 true );
-	oclBuffer_opt_cx		= new COCLBuffer( "opt_cx Values",			oclModel, true,	 true );
-	oclBuffer_opt_zymax		= new COCLBuffer( "opt_zymax Values",		oclModel, true,	 true );
-	oclBuffer_opt_cy		= new COCLBuffer( "opt_cy Values",			oclModel, true,	 true );
+	oclBufferPoleniMasks	= new COCLBuffer( "Poleni face masks",		oclModel, true,	 true );
+	oclBufferWeirFaceIDs	= new COCLBuffer( "Weir face IDs",			oclModel, true,	 true );
+	oclBufferWeirFaceValues	= new COCLBuffer( "Weir face values",		oclModel, true,	 true );
 	oclBufferCellBed		= new COCLBuffer( "Bed elevations",			oclModel, true,  true );
 
 	oclBufferCellStates	  ->setPointer( pCellStates,	 ucFloatSize * 4 * pDomain->getCellCount() );
 	oclBufferCellStatesAlt->setPointer( pCellStates,	 ucFloatSize * 4 * pDomain->getCellCount() );
-	oclBufferCellManning  ->setPointer( pManningValues,  ucFloatSize * pDomain->getCellCount() );
+	oclBufferCellManning  ->setPointer( pManningValues,  ucStaticFloatSize * pDomain->getCellCount() );
 	if (this->bUseOptimizedBoundary == false) {
 		oclBufferCellBoundary->setPointer(pBoundaryValues, ucFloatSize * pDomain->getCellCount());
 	}
@@ -657,12 +1845,10 @@ bool CSchemeGodunov::prepare1OMemory()
 		oclBufferCouplingIDs->setPointer( pCouplingIDs, sizeof(cl_ulong) * this->ulCouplingArraySize);
 		oclBufferCouplingValues->setPointer( pCouplingValues, ucFloatSize * this->ulCouplingArraySize);
 	}
-	oclBufferUsePoleni    ->setPointer( pPoleniValues,	 sizeof(sUsePoleni) * pDomain->getCellCount() );
-	oclBuffer_opt_zxmax   ->setPointer( pOpt_zxmax,		 ucFloatSize * pDomain->getCellCount() );
-	oclBuffer_opt_cx      ->setPointer( pOpt_cx,		 ucFloatSize * pDomain->getCellCount() );
-	oclBuffer_opt_zymax   ->setPointer( pOpt_zymax,		 ucFloatSize * pDomain->getCellCount() );
-	oclBuffer_opt_cy      ->setPointer( pOpt_cy,		 ucFloatSize * pDomain->getCellCount() );
-	oclBufferCellBed      ->setPointer( pBedElevations,  ucFloatSize * pDomain->getCellCount() );
+	oclBufferPoleniMasks  ->setPointer( pPoleniMasks,	 sizeof(cl_uchar) * pDomain->getCellCount() );
+	oclBufferWeirFaceIDs  ->setPointer( pWeirFaceIDs,	 sizeof(cl_ulong) * pDomain->getWeirFaceCapacity() );
+	oclBufferWeirFaceValues->setPointer( pWeirFaceValues, ucStaticFloatSize * 2 * pDomain->getWeirFaceCapacity() );
+	oclBufferCellBed      ->setPointer( pBedElevations,  ucStaticFloatSize * pDomain->getCellCount() );
 
 	oclBufferCellStates->createBuffer();
 	oclBufferCellStatesAlt->createBuffer();
@@ -674,48 +1860,60 @@ bool CSchemeGodunov::prepare1OMemory()
 		oclBufferCouplingIDs->createBuffer();
 		oclBufferCouplingValues->createBuffer();
 	}
-	oclBufferUsePoleni->createBuffer();
-	oclBuffer_opt_zxmax->createBuffer();
-	oclBuffer_opt_cx->createBuffer();
-	oclBuffer_opt_zymax->createBuffer();
-	oclBuffer_opt_cy->createBuffer();
+	oclBufferPoleniMasks->createBuffer();
+	oclBufferWeirFaceIDs->createBuffer();
+	oclBufferWeirFaceValues->createBuffer();
 	oclBufferCellBed->createBuffer();
 
-	// --
-	// Timesteps and current simulation time
-	// --
+	// Copies of the bed elevations and Manning values the non-cached flux kernel 
+	// samples, with doubles packed into two 32-bit channels
+	if ( this->isStaticImagesEnabled() )
+	{
+		cl_channel_order	clOrder		= ( ucStaticFloatSize == sizeof( cl_double ) ? CL_RG : CL_R );
+		cl_channel_type		clType		= ( ucStaticFloatSize == sizeof( cl_double ) ? CL_UNSIGNED_INT32 : CL_FLOAT );
 
-	oclBufferTimestep			= new COCLBuffer( "Timestep", oclModel, false, true, ucFloatSize, true );
-	oclBufferTime				= new COCLBuffer( "Time",	  oclModel, false, true, ucFloatSize, true );
-	oclBufferTimeTarget			= new COCLBuffer( "Target time (sync)",	  oclModel, false, true, ucFloatSize, true );
-	oclBufferTimeHydrological	= new COCLBuffer("Time (hydrological)", oclModel, false, true, ucFloatSize, true);
+		oclBufferCellBedImage = new COCLBuffer( "Bed elevations (image)", oclModel, true, true );
+		oclBufferCellBedImage->setPointer( pBedElevations, ucStaticFloatSize * pDomain->getCellCount() );
+		oclBufferCellBedImage->createImage2D( pDomain->getCols(), pDomain->getRows(), clOrder, clType );
 
-	// We duplicate the time and timestep variables if we're using single-precision so we have copies in both formats
-	if (cModel->getFloatPrecision() == model::floatPrecision::kSingle)
+		if ( this->isManningImageEnabled() )
+		{
+			oclBufferCellManningImage = new COCLBuffer( "Manning coefficients (image)", oclModel, true, true );
+			oclBufferCellManningImage->setPointer( pManningValues, ucStaticFloatSize * pDomain->getCellCount() );
+			oclBufferCellManningImage->createImage2D( pDomain->getCols(), pDomain->getRows(), clOrder, clType );
+		}
+	}
+
+	// Coupling values are scattered into a dense array when the flux kernel applies them
+	if ( this->bUseOptimizedBoundary && this->isBoundaryFused() )
 	{
-		*( oclBufferTime->getHostBlock<float*>()     )			= static_cast<cl_float>( this->dCurrentTime );
-		*( oclBufferTimestep->getHostBlock<float*>() )			= static_cast<cl_float>( this->dCurrentTimestep );
-		*(oclBufferTimeHydrological->getHostBlock<float*>()) = 0.0f;
-		*( oclBufferTimeTarget->getHostBlock<float*>() )		= 0.0f;
-	} else {
-		*( oclBufferTime->getHostBlock<double*>()     )			= this->dCurrentTime;
-		*( oclBufferTimestep->getHostBlock<double*>() )			= this->dCurrentTimestep;
-		*(oclBufferTimeHydrological->getHostBlock<double*>()) = 0.0;
-		*( oclBufferTimeTarget->getHostBlock<double*>() )		= 0.0;
+		oclBufferBoundaryRates = new COCLBuffer( "Boundary rates", oclModel, false, true, ucFloatSize * pDomain->getCellCount(), true );
+		oclBufferBoundaryRates->createBuffer();
 	}
 
-	oclBufferTimestep->createBuffer();
-	oclBufferTime->createBuffer();
-	oclBufferTimeHydrological->createBuffer();
-	oclBufferTimeTarget->createBuffer();
+	// --
+	// Low-order part of the levels for double-float (one float per cell)
+	// --
+
+	oclBufferCellFSLLow = new COCLBuffer( "Cell levels (low-order)", oclModel, false, true, ( this->isDoubleFloatEnabled() ? pDomain->getCellCount() : 1 ) * sizeof( cl_float ), true );
+	oclBufferCellFSLLow->createBuffer();
 
 	// --
 	// Timestep reduction global array
 	// --
 
-	oclBufferTimestepReduction = new COCLBuffer( "Timestep reduction scratch", oclModel, false, true, this->ulReductionGlobalSize * ucFloatSize, true );
+	oclBufferTimestepReduction = new COCLBuffer( "Timestep reduction scratch", oclModel, false, true, ( this->isAtomicReductionEnabled() ? 1 : this->ulReductionGlobalSize ) * ucFloatSize, true );
 	oclBufferTimestepReduction->createBuffer();
 
+	// --
+	// Active tiles (list holds the count first, then the tile IDs)
+	// --
+
+	oclBufferTileFlags		= new COCLBuffer( "Tile flags", oclModel, false, true, this->ulActiveTilesX * this->ulActiveTilesY * sizeof( cl_uint ), true );
+	oclBufferActiveTiles	= new COCLBuffer( "Active tiles", oclModel, false, true, ( this->ulActiveTilesX * this->ulActiveTilesY + 1 ) * sizeof( cl_uint ), true );
+	oclBufferTileFlags->createBuffer();
+	oclBufferActiveTiles->createBuffer();
+
 	// TODO: Check buffers were created successfully before returning a positive response
 
 	// VISUALISER STUFF
@@ -763,6 +1961,16 @@ bool CSchemeGodunov::prepareGeneralKernels()
 	oclKernelTimestepReduction->assignArguments(aryArgsTimeReduction);
 	oclKernelTimestepUpdate->assignArguments(aryArgsTimestepUpdate);
 
+	// Restarts the timestep in place of the first iteration after a sync
+	if ( this->isZeroTimestepSkipEnabled() )
+	{
+		oclKernelTimestepResume = oclModel->getKernel("tst_ResumeTimestep");
+		oclKernelTimestepResume->setGroupSize(1, 1, 1);
+		oclKernelTimestepResume->setGlobalSize(1, 1, 1);
+		COCLBuffer* aryArgsTimestepResume[] = { oclBufferTime, oclBufferTimestep, oclBufferTimestepReduction, oclBufferTimeTarget };
+		oclKernelTimestepResume->assignArguments(aryArgsTimestepResume);
+	}
+
 	// --
 	// Boundary Kernel
 	// --
@@ -777,7 +1985,7 @@ bool CSchemeGodunov::prepareGeneralKernels()
 		//oclKernelBoundary->setGlobalSize((cl_ulong)ceil(cd->getCols() / 8.0) * 8, (cl_ulong)ceil(cd->getRows() / 8.0) * 8);
 
 		// TODO: Alaa: remove the hydrological buffer and code
-		COCLBuffer* aryArgsBdy[] = { oclBufferCellBoundary, oclBufferTimestep, oclBufferTimeHydrological ,oclBufferCellStates, oclBufferCellBed };
+		COCLBuffer* aryArgsBdy[] = { oclBufferCellBoundary, oclBufferTimestep, oclBufferTimeHydrological ,oclBufferCellStates, oclBufferCellBed, oclBufferActiveTiles };
 
 		oclKernelBoundary->assignArguments(aryArgsBdy);
 
@@ -792,8 +2000,81 @@ bool CSchemeGodunov::prepareGeneralKernels()
 		COCLBuffer* aryArgsBdy[] = { oclBufferCouplingIDs, oclBufferCouplingValues, oclBufferTimestep ,oclBufferCellStates, oclBufferCellBed };
 
 		oclKernelBoundary->assignArguments(aryArgsBdy);
+
+		if ( this->isBoundaryFused() )
+		{
+			oclKernelBoundaryScatter = oclModel->getKernel("bdy_ScatterCouplingRates");
+			oclKernelBoundaryScatter->setGroupSize(8);
+			oclKernelBoundaryScatter->setGlobalSize(8*ceil(this->ulCouplingArraySize/8.0));
+
+			COCLBuffer* aryArgsScatter[] = { oclBufferCouplingIDs, oclBufferCouplingValues, oclBufferBoundaryRates };
+
+			oclKernelBoundaryScatter->assignArguments(aryArgsScatter);
+		}
+	}
+
+
+	// --
+	// Active tile kernels
+	// --
+
+	if ( this->isActiveTilesEnabled() )
+	{
+		oclKernelTileFlag = oclModel->getKernel( "act_FlagTiles" );
+		oclKernelTileFlag->setGroupSize( this->ulNonCachedWorkgroupSizeX, this->ulNonCachedWorkgroupSizeY );
+		oclKernelTileFlag->setGlobalSize( this->ulNonCachedGlobalSizeX, this->ulNonCachedGlobalSizeY );
+		COCLBuffer* aryArgsTileFlag[] = { oclBufferCellStates, oclBufferCellBed, this->getBoundaryRateBuffer(), oclBufferTileFlags, oclBufferActiveTiles };
+		oclKernelTileFlag->assignArguments( aryArgsTileFlag );
+
+		if ( this->bUseOptimizedBoundary )
+		{
+			oclKernelTilePin = oclModel->getKernel( "act_PinTiles" );
+			oclKernelTilePin->setGroupSize( 8 );
+			oclKernelTilePin->setGlobalSize( 8*ceil( this->ulCouplingArraySize/8.0 ) );
+			COCLBuffer* aryArgsTilePin[] = { oclBufferCouplingIDs, oclBufferTileFlags };
+			oclKernelTilePin->assignArguments( aryArgsTilePin );
+		}
+
+		oclKernelTileCompact = oclModel->getKernel( "act_CompactTiles" );
+		oclKernelTileCompact->setGroupSize( this->ulNonCachedWorkgroupSizeX * this->ulNonCachedWorkgroupSizeY );
+		oclKernelTileCompact->setGlobalSize( this->ulActiveTilesX * this->ulActiveTilesY );
+		COCLBuffer* aryArgsTileCompact[] = { oclBufferTileFlags, oclBufferActiveTiles };
+		oclKernelTileCompact->assignArguments( aryArgsTileCompact );
+
+		oclKernelTileSync = oclModel->getKernel( "act_SyncTiles" );
+		oclKernelTileSync->setGroupSize( this->ulNonCachedWorkgroupSizeX, this->ulNonCachedWorkgroupSizeY );
+		oclKernelTileSync->setGlobalSize( this->ulNonCachedGlobalSizeX, this->ulNonCachedGlobalSizeY );
+		COCLBuffer* aryArgsTileSync[] = { oclBufferCellStates, oclBufferCellStatesAlt, oclBufferTileFlags };
+		oclKernelTileSync->assignArguments( aryArgsTileSync );
 	}
 
+	// --
+	// Wet extent kernels
+	// --
+
+	if ( this->isWetExtentEnabled() )
+	{
+		oclKernelWetExtent = oclModel->getKernel( "dom_WetExtent" );
+		oclKernelWetExtent->setGroupSize( this->ulNonCachedWorkgroupSizeX, this->ulNonCachedWorkgroupSizeY );
+		oclKernelWetExtent->setGlobalSize( this->ulNonCachedGlobalSizeX, this->ulNonCachedGlobalSizeY );
+		COCLBuffer* aryArgsWetExtent[] = { oclBufferCellStates, oclBufferCellBed, this->getBoundaryRateBuffer(), oclBufferWetExtent };
+		oclKernelWetExtent->assignArguments( aryArgsWetExtent );
+
+		if ( this->bUseOptimizedBoundary )
+		{
+			oclKernelWetExtentCoupling = oclModel->getKernel( "dom_WetExtentCoupling" );
+			oclKernelWetExtentCoupling->setGroupSize( 8 );
+			oclKernelWetExtentCoupling->setGlobalSize( 8*ceil( this->ulCouplingArraySize/8.0 ) );
+			COCLBuffer* aryArgsWetExtentCoupling[] = { oclBufferCouplingIDs, oclBufferWetExtent };
+			oclKernelWetExtentCoupling->assignArguments( aryArgsWetExtentCoupling );
+		}
+
+		oclKernelWetSync = oclModel->getKernel( "dom_SyncStates" );
+		oclKernelWetSync->setGroupSize( this->ulNonCachedWorkgroupSizeX, this->ulNonCachedWorkgroupSizeY );
+		oclKernelWetSync->setGlobalSize( this->ulNonCachedGlobalSizeX, this->ulNonCachedGlobalSizeY );
+		COCLBuffer* aryArgsWetSync[] = { oclBufferCellStates, oclBufferCellStatesAlt };
+		oclKernelWetSync->assignArguments( aryArgsWetSync );
+	}
 
 	// --
 	// Friction Kernel
@@ -825,10 +2106,10 @@ bool CSchemeGodunov::prepare1OKernels()
 
 	if ( this->ucConfiguration == model::schemeConfigurations::godunovType::kCacheNone )
 	{
-		oclKernelFullTimestep = oclModel->getKernel( "gts_cacheDisabled" );
+		oclKernelFullTimestep = oclModel->getKernel( this->isStripMiningEnabled() ? "gts_cacheDisabledStrip" : "gts_cacheDisabled" );
 		oclKernelFullTimestep->setGroupSize( this->ulNonCachedWorkgroupSizeX, this->ulNonCachedWorkgroupSizeY );
-		oclKernelFullTimestep->setGlobalSize( this->ulNonCachedGlobalSizeX, this->ulNonCachedGlobalSizeY );
-		COCLBuffer* aryArgsFullTimestep[] = { oclBufferTimestep, oclBufferCellBed, oclBufferCellStates, oclBufferCellStatesAlt, oclBufferCellManning, oclBufferUsePoleni, oclBuffer_opt_zxmax, oclBuffer_opt_zymax };
+		oclKernelFullTimestep->setGlobalSize( this->ulNonCachedGlobalSizeX, this->isStripMiningEnabled() ? this->ulStripGlobalSizeY : this->ulNonCachedGlobalSizeY );
+		COCLBuffer* aryArgsFullTimestep[] = { oclBufferTimestep, this->getStaticBedBuffer(), oclBufferCellStates, oclBufferCellStatesAlt, this->getStaticManningBuffer(), oclBufferPoleniMasks, oclBufferWeirFaceIDs, oclBufferWeirFaceValues, oclBufferTimestepReduction, this->getBoundaryRateBuffer(), oclBufferActiveTiles, oclBufferCellFSLLow };
 		oclKernelFullTimestep->assignArguments( aryArgsFullTimestep );
 	}
 	if ( this->ucConfiguration == model::schemeConfigurations::godunovType::kCacheEnabled )
@@ -843,6 +2124,29 @@ bool CSchemeGodunov::prepare1OKernels()
 	return bReturnState;
 }
 
+/*
+ *  Give each kernel reading or writing the cell states a second instance with
+ *  the source and destination swapped, so iterations only pick an instance
+ *  Very carefully watch the index of arguments assignment, there are no safety checks for them
+ */
+bool CSchemeGodunov::prepareAlternateKernels()
+{
+	bool bReturnState = true;
+
+	bReturnState &= oclKernelFullTimestep->assignArgument( 2, oclBufferCellStates );					// Src
+	bReturnState &= oclKernelFullTimestep->assignArgument( 3, oclBufferCellStatesAlt );					// Dst
+	bReturnState &= oclKernelFullTimestep->assignAlternateArgument( 2, oclBufferCellStatesAlt );		// Src
+	bReturnState &= oclKernelFullTimestep->assignAlternateArgument( 3, oclBufferCellStates );			// Dst
+	bReturnState &= oclKernelBoundary->assignArgument( 3, oclBufferCellStatesAlt );						// Dst
+	bReturnState &= oclKernelBoundary->assignAlternateArgument( 3, oclBufferCellStates );				// Dst
+	bReturnState &= oclKernelFriction->assignArgument( 1, oclBufferCellStatesAlt );						// Dst
+	bReturnState &= oclKernelFriction->assignAlternateArgument( 1, oclBufferCellStates );				// Dst
+	bReturnState &= oclKernelTimestepReduction->assignArgument( 0, oclBufferCellStatesAlt );			// Dst
+	bReturnState &= oclKernelTimestepReduction->assignAlternateArgument( 0, oclBufferCellStates );		// Dst
+
+	return bReturnState;
+}
+
 /*
  *  Release all OpenCL resources consumed using the OpenCL methods
  */
@@ -871,6 +2175,16 @@ void CSchemeGodunov::release1OResources()
 	if ( this->oclKernelTimestepReduction != NULL )			delete oclKernelTimestepReduction;
 	if ( this->oclKernelTimeAdvance != NULL )				delete oclKernelTimeAdvance;
 	if ( this->oclKernelTimestepUpdate != NULL )			delete oclKernelTimestepUpdate;
+	if ( this->oclKernelTimestepResume != NULL )			delete oclKernelTimestepResume;
+	if ( this->oclKernelBoundaryScatter != NULL )			delete oclKernelBoundaryScatter;
+	if ( this->oclKernelTileFlag != NULL )					delete oclKernelTileFlag;
+	if ( this->oclKernelTilePin != NULL )					delete oclKernelTilePin;
+	if ( this->oclKernelTileCompact != NULL )				delete oclKernelTileCompact;
+	if ( this->oclKernelTileSync != NULL )					delete oclKernelTileSync;
+	if ( this->oclKernelWetExtent != NULL )					delete oclKernelWetExtent;
+	if ( this->oclKernelWetExtentCoupling != NULL )			delete oclKernelWetExtentCoupling;
+	if ( this->oclKernelWetSync != NULL )					delete oclKernelWetSync;
+	if ( this->oclKernelPersistentLoop != NULL )			delete oclKernelPersistentLoop;
 	if ( this->oclKernelResetCounters != NULL )				delete oclKernelResetCounters;
 	if ( this->oclBufferCellStates != NULL )				delete oclBufferCellStates;
 	if ( this->oclBufferCellStatesAlt != NULL )				delete oclBufferCellStatesAlt;
@@ -878,17 +2192,27 @@ void CSchemeGodunov::release1OResources()
 	if ( this->oclBufferCellBoundary != NULL )				delete oclBufferCellBoundary;
 	if ( this->oclBufferCouplingIDs != NULL )				delete oclBufferCouplingIDs;
 	if ( this->oclBufferCouplingValues != NULL )			delete oclBufferCouplingValues;
-	if ( this->oclBufferUsePoleni != NULL )					delete oclBufferUsePoleni;
-	if ( this->oclBuffer_opt_zxmax != NULL )				delete oclBuffer_opt_zxmax;
-	if ( this->oclBuffer_opt_cx != NULL )					delete oclBuffer_opt_cx;
-	if ( this->oclBuffer_opt_zymax != NULL )				delete oclBuffer_opt_zymax;
-	if ( this->oclBuffer_opt_cy != NULL )					delete oclBuffer_opt_cy;
+	if ( this->oclBufferBoundaryRates != NULL )				delete oclBufferBoundaryRates;
+	if ( this->oclBufferTileFlags != NULL )					delete oclBufferTileFlags;
+	if ( this->oclBufferActiveTiles != NULL )				delete oclBufferActiveTiles;
+	if ( this->oclBufferWetExtent != NULL )					delete oclBufferWetExtent;
+	if ( this->oclBufferIterationBudget != NULL )			delete oclBufferIterationBudget;
+	if ( this->oclBufferPoleniMasks != NULL )				delete oclBufferPoleniMasks;
+	if ( this->oclBufferWeirFaceIDs != NULL )				delete oclBufferWeirFaceIDs;
+	if ( this->oclBufferWeirFaceValues != NULL )			delete oclBufferWeirFaceValues;
+	if ( this->oclBufferCellFSLLow != NULL )				delete oclBufferCellFSLLow;
 	if ( this->oclBufferCellBed != NULL )					delete oclBufferCellBed;
+	if ( this->oclBufferCellBedImage != NULL )				delete oclBufferCellBedImage;
+	if ( this->oclBufferCellManningImage != NULL )			delete oclBufferCellManningImage;
 	if ( this->oclBufferTimestep != NULL )					delete oclBufferTimestep;
 	if ( this->oclBufferTimestepReduction != NULL )			delete oclBufferTimestepReduction;
 	if ( this->oclBufferTime != NULL )						delete oclBufferTime;
 	if ( this->oclBufferTimeTarget != NULL )				delete oclBufferTimeTarget;
 	if (this->oclBufferTimeHydrological != NULL)			delete oclBufferTimeHydrological;
+	if ( this->oclBufferBatchTimesteps != NULL )			delete oclBufferBatchTimesteps;
+	if ( this->oclBufferBatchSuccessful != NULL )			delete oclBufferBatchSuccessful;
+	if ( this->oclBufferBatchSkipped != NULL )				delete oclBufferBatchSkipped;
+	if ( this->oclBufferBatchStatus != NULL )				delete oclBufferBatchStatus;
 
 	oclModel						= NULL;
 	oclKernelFullTimestep			= NULL;
@@ -898,23 +2222,43 @@ void CSchemeGodunov::release1OResources()
 	oclKernelTimeAdvance			= NULL;
 	oclKernelResetCounters			= NULL;
 	oclKernelTimestepUpdate			= NULL;
+	oclKernelTimestepResume			= NULL;
+	oclKernelBoundaryScatter		= NULL;
+	oclKernelTileFlag				= NULL;
+	oclKernelTilePin				= NULL;
+	oclKernelTileCompact			= NULL;
+	oclKernelTileSync				= NULL;
+	oclKernelWetExtent				= NULL;
+	oclKernelWetExtentCoupling		= NULL;
+	oclKernelWetSync				= NULL;
+	oclKernelPersistentLoop			= NULL;
 	oclBufferCellStates				= NULL;
 	oclBufferCellStatesAlt			= NULL;
 	oclBufferCellManning			= NULL;
 	oclBufferCellBoundary			= NULL;
 	oclBufferCouplingIDs			= NULL;
 	oclBufferCouplingValues			= NULL;
-	oclBufferUsePoleni				= NULL;
-	oclBuffer_opt_zxmax				= NULL;
-	oclBuffer_opt_cx				= NULL;
-	oclBuffer_opt_zymax				= NULL;
-	oclBuffer_opt_cy				= NULL;
+	oclBufferBoundaryRates			= NULL;
+	oclBufferTileFlags				= NULL;
+	oclBufferActiveTiles			= NULL;
+	oclBufferWetExtent				= NULL;
+	oclBufferIterationBudget		= NULL;
+	oclBufferPoleniMasks			= NULL;
+	oclBufferWeirFaceIDs			= NULL;
+	oclBufferWeirFaceValues			= NULL;
+	oclBufferCellFSLLow				= NULL;
 	oclBufferCellBed				= NULL;
+	oclBufferCellBedImage			= NULL;
+	oclBufferCellManningImage		= NULL;
 	oclBufferTimestep				= NULL;
 	oclBufferTimestepReduction		= NULL;
 	oclBufferTime					= NULL;
 	oclBufferTimeTarget				= NULL;
 	oclBufferTimeHydrological = NULL;
+	oclBufferBatchTimesteps			= NULL;
+	oclBufferBatchSuccessful		= NULL;
+	oclBufferBatchSkipped			= NULL;
+	oclBufferBatchStatus			= NULL;
 
 	if ( this->bIncludeBoundaries )
 	{
@@ -938,6 +2282,13 @@ void CSchemeGodunov::release1OResources()
  */
 void	CSchemeGodunov::prepareSimulation()
 {
+	// Weir faces set since the scheme was built are sorted into the table, which
+	// needs a rebuild when the kernels were sized for a different number
+	bool bWeirFacesResized = this->pDomain->commitWeirFaces();
+
+	// Tuning needs the real domain, as a dry one only times the launches
+	if ( !this->autotuneExecDimensions() && bWeirFacesResized )
+		this->prepareAll();
 
 	// Initial volume in the domain
 	model::log->writeLine( "Initial domain volume: " + toStringExact( abs((int)(this->pDomain->getVolume()) ) ) + "m3" );
@@ -948,18 +2299,25 @@ void	CSchemeGodunov::prepareSimulation()
 	oclBufferCellStatesAlt->queueWriteAll();
 	oclBufferCellBed->queueWriteAll();
 	oclBufferCellManning->queueWriteAll();
+	if ( this->oclBufferCellBedImage != NULL )
+		oclBufferCellBedImage->queueWriteAll();
+	if ( this->oclBufferCellManningImage != NULL )
+		oclBufferCellManningImage->queueWriteAll();
 	if (this->bUseOptimizedBoundary == false) {
 		oclBufferCellBoundary->queueWriteAll();
 	}
 	else {
 		oclBufferCouplingIDs->queueWriteAll();
 		oclBufferCouplingValues->queueWriteAll();
+		if ( this->isBoundaryFused() )
+		{
+			pDomain->getDevice()->queueBarrier();
+			oclKernelBoundaryScatter->scheduleExecution();
+		}
 	}
-	oclBufferUsePoleni->queueWriteAll();
-	oclBuffer_opt_zxmax->queueWriteAll();
-	oclBuffer_opt_cx->queueWriteAll();
-	oclBuffer_opt_zymax->queueWriteAll();
-	oclBuffer_opt_cy->queueWriteAll();
+	oclBufferPoleniMasks->queueWriteAll();
+	oclBufferWeirFaceIDs->queueWriteAll();
+	oclBufferWeirFaceValues->queueWriteAll();
 	oclBufferTime->queueWriteAll();
 	oclBufferTimestep->queueWriteAll();
 	oclBufferTimeHydrological->queueWriteAll();
@@ -979,9 +2337,17 @@ void	CSchemeGodunov::prepareSimulation()
 	// Zero counters
 	ulCurrentCellsCalculated	= 0;
 	uiIterationsSinceSync		= 0;
+	uiIterationsSinceCompaction	= 0;
 	uiIterationsSinceProgressCheck = 0;
 	dLastSyncTime				= 0.0;
 
+	// Launch over the whole domain until the wet extent is known
+	bWetExtentValid				= false;
+	ulWetBoxOffsetX				= 0;
+	ulWetBoxOffsetY				= 0;
+	ulWetBoxSizeX				= this->ulNonCachedGlobalSizeX;
+	ulWetBoxSizeY				= this->ulNonCachedGlobalSizeY;
+
 	// States
 	bRunning = false;
 	bThreadRunning = false;
@@ -1040,12 +2406,16 @@ void CSchemeGodunov::Threaded_runBatch()
 		}
 
 		this->cModel->profiler->profile("BatchRunning", CProfiler::profilerFlags::START_PROFILING);
+
+		// Skipped iterations so far, to find how many this batch adds
+		cl_uint uiSkippedBefore = this->uiBatchSkipped;
+
 		// Have we been asked to update the target time?
 		if (this->bUpdateTargetTime)
 		{
 			this->bUpdateTargetTime = false;
 
-			if (cModel->getFloatPrecision() == model::floatPrecision::kSingle)
+			if (cModel->getFloatPrecision() != model::floatPrecision::kDouble)
 			{
 				*(oclBufferTimeTarget->getHostBlock<float*>()) = static_cast<cl_float>(this->dTargetTime);
 			}
@@ -1053,7 +2423,6 @@ void CSchemeGodunov::Threaded_runBatch()
 				*(oclBufferTimeTarget->getHostBlock<double*>()) = this->dTargetTime;
 			}
 			oclBufferTimeTarget->queueWriteAll();
-			pDomain->getDevice()->queueBarrier();
 
 			this->uiIterationsSinceSync = 0;
 
@@ -1071,16 +2440,13 @@ void CSchemeGodunov::Threaded_runBatch()
 			 //	oclKernelTimestepUpdate->scheduleExecution();
 			 //}
 
-			if ( dCurrentTime + dCurrentTimestep > dTargetTime )
+			if ( dCurrentTime + dCurrentTimestep * this->getStepsPerIteration() > dTargetTime )
 			{
-				this->dCurrentTimestep  = dTargetTime - dCurrentTime;
+				this->dCurrentTimestep  = ( dTargetTime - dCurrentTime ) / this->getStepsPerIteration();
 				this->bOverrideTimestep = true;
 				std::cout << "Override Timestep Requested" << std::endl;
 			}
 
-			pDomain->getDevice()->queueBarrier();
-			//pDomain->getDevice()->blockUntilFinished();		// Shouldn't be needed
-
 		}
 
 		// Have we been asked to override the timestep at the start of this batch?
@@ -1090,7 +2456,7 @@ void CSchemeGodunov::Threaded_runBatch()
 
 			this->bOverrideTimestep = false;
 
-			if (cModel->getFloatPrecision() == model::floatPrecision::kSingle)
+			if (cModel->getFloatPrecision() != model::floatPrecision::kDouble)
 			{
 				*(oclBufferTimestep->getHostBlock<float*>()) = static_cast<cl_float>(this->dCurrentTimestep);
 			}
@@ -1100,10 +2466,6 @@ void CSchemeGodunov::Threaded_runBatch()
 
 			oclBufferTimestep->queueWriteAll();
 
-			// TODO: Remove me?
-			pDomain->getDevice()->queueBarrier();
-			//pDomain->getDevice()->blockUntilFinished();
-
 		}
 
 		// Have we been asked to import new data?
@@ -1112,13 +2474,7 @@ void CSchemeGodunov::Threaded_runBatch()
 			this->bImportLinks = false;
 
 			this->cModel->profiler->profile("Boundary Write", CProfiler::profilerFlags::START_PROFILING);
-			if (this->bUseOptimizedBoundary == false) {
-				this->oclBufferCellBoundary->queueWriteAll();
-			}
-			else {
-				this->oclBufferCouplingValues->queueWriteAll();
-			}
-			pDomain->getDevice()->queueBarrier();
+			this->scheduleBoundaryWrite( pDomain->getDevice() );
 
 			this->cModel->profiler->profile("Boundary Write", CProfiler::profilerFlags::END_PROFILING, this->pDomain->getDevice());
 
@@ -1126,9 +2482,13 @@ void CSchemeGodunov::Threaded_runBatch()
 			this->dLastSyncTime = this->dCurrentTime;
 			this->uiIterationsSinceSync = 0;
 
+			// New boundary rates may wet tiles that are currently inactive, or cells outside the wet extent
+			this->uiIterationsSinceCompaction = 0;
+			this->bWetExtentValid = false;
+
 			/* Removed temporary to check if it has good or bad effect on simulation
 			// Set Small Timestep
-			if (cModel->getFloatPrecision() == model::floatPrecision::kSingle){
+			if (cModel->getFloatPrecision() != model::floatPrecision::kDouble){
 				*(oclBufferTimestep->getHostBlock<float*>()) = static_cast<cl_float>(0.1);
 			}
 			else {
@@ -1142,7 +2502,7 @@ void CSchemeGodunov::Threaded_runBatch()
 			this->cModel->profiler->profile("oclKernelResetCounters", CProfiler::profilerFlags::START_PROFILING);
 			// Reset Counters
 			oclKernelResetCounters->scheduleExecution();
-			pDomain->getDevice()->queueBarrier();
+			uiSkippedBefore = 0;
 			this->cModel->profiler->profile("oclKernelResetCounters", CProfiler::profilerFlags::END_PROFILING, this->pDomain->getDevice());
 
 			/*
@@ -1166,6 +2526,10 @@ void CSchemeGodunov::Threaded_runBatch()
 		//	continue;
 		//}
 
+		// The uploads and counter reset above don't depend on one another, so an
+		// out-of-order queue can overlap them, but the iterations need them all
+		pDomain->getDevice()->queueBarrier();
+
 		// Can only schedule one iteration before we need to sync timesteps
 		// if timestep sync method is active.
 		unsigned int uiQueueAmount = this->uiQueueAdditionSize;
@@ -1173,30 +2537,56 @@ void CSchemeGodunov::Threaded_runBatch()
 		// Schedule a batch-load of work for the device
 		// Do we need to run any work?
 		if ( this->dCurrentTime < dTargetTime ) {
-			for (unsigned int i = 0; i < uiQueueAmount; i++)
+
+			// Shrink the launches to the wet extent from the end of the last batch
+			if ( this->isWetExtentEnabled() )
+				this->applyWetExtent( bUseAlternateKernel, uiQueueAmount, pDomain->getDevice() );
+
+			// Restart the timestep rather than spend the first iteration on it
+			if ( this->bUseForcedTimeAdvance && this->isZeroTimestepSkipEnabled() )
 			{
+				this->bUseForcedTimeAdvance = false;
+				this->scheduleTimestepResume( bUseAlternateKernel, pDomain->getDevice() );
+			}
 
-				this->scheduleIteration(
+			if ( this->isPersistentLoopEnabled() )
+			{
+				// The whole batch is a single launch, which leaves the states where one iteration would
+				this->schedulePersistentLoop(
 					bUseAlternateKernel,
-					pDomain->getDevice(),
-					pDomain
+					uiQueueAmount,
+					pDomain->getDevice()
 				);
-				uiIterationsSinceSync++;
-				uiIterationsSinceProgressCheck++;
-				ulCurrentCellsCalculated += this->pDomain->getCellCount();
+				uiIterationsSinceSync += uiQueueAmount;
+				uiIterationsSinceProgressCheck += uiQueueAmount;
+				ulCurrentCellsCalculated += this->pDomain->getCellCount() * uiQueueAmount;
 				bUseAlternateKernel = !bUseAlternateKernel;
+			} else {
+				for (unsigned int i = 0; i < uiQueueAmount; i++)
+				{
+
+					this->scheduleIteration(
+						bUseAlternateKernel,
+						pDomain->getDevice(),
+						pDomain
+					);
+					uiIterationsSinceSync++;
+					uiIterationsSinceProgressCheck++;
+					ulCurrentCellsCalculated += this->pDomain->getCellCount() * this->getStepsPerIteration();
+					bUseAlternateKernel = !bUseAlternateKernel;
+				}
 			}
 
+			if ( this->isWetExtentEnabled() )
+				this->scheduleWetExtent( bUseAlternateKernel, pDomain->getDevice() );
+
 		}
 
 		// Schedule reading data back. We always need the timestep but we might not need the other details always...
 
 		this->cModel->profiler->profile("QueueReading", CProfiler::profilerFlags::START_PROFILING);
-		oclBufferTimestep->queueReadAll();
-		oclBufferTime->queueReadAll();
-		oclBufferBatchSkipped->queueReadAll();
-		oclBufferBatchSuccessful->queueReadAll();
-		oclBufferBatchTimesteps->queueReadAll();
+		// One transfer covers the time, timestep, batch counters and wet extent
+		oclBufferBatchStatus->queueReadPartial( 0, static_cast<size_t>( this->ulBatchStatusReadSize ) );
 		uiIterationsSinceProgressCheck = 0;
 		this->cModel->profiler->profile("QueueReading", CProfiler::profilerFlags::END_PROFILING, this->pDomain->getDevice());
 
@@ -1212,6 +2602,11 @@ void CSchemeGodunov::Threaded_runBatch()
 		this->readKeyStatistics();
 		this->cModel->profiler->profile("readStats", CProfiler::profilerFlags::END_PROFILING, this->pDomain->getDevice());
 
+		// A skipped iteration left the states in its source buffer, so an odd
+		// number of them puts the next source back where the last one was
+		if ( this->isZeroTimestepSkipEnabled() && ( this->uiBatchSkipped - uiSkippedBefore ) % 2 == 1 )
+			bUseAlternateKernel = !bUseAlternateKernel;
+
 		//Alaa: Shouldn't we block until the read is finished?
 		this->pDomain->getDevice()->blockUntilFinished();
 
@@ -1307,12 +2702,14 @@ void	CSchemeGodunov::rollbackSimulation( double dCurrentTime, double dTargetTime
 	this->getDomain()->getDevice()->blockUntilFinished();
 
 	uiIterationsSinceSync = 0;
+	uiIterationsSinceCompaction = 0;
+	bWetExtentValid = false;
 
 	this->dCurrentTime = dCurrentTime;
 	this->dTargetTime = dTargetTime;
 
 	// Update the time
-	if (cModel->getFloatPrecision() == model::floatPrecision::kSingle)
+	if (cModel->getFloatPrecision() != model::floatPrecision::kDouble)
 	{
 		*( oclBufferTime->getHostBlock<float*>() )	= static_cast<cl_float>( dCurrentTime );
 		*( oclBufferTimeTarget->getHostBlock<float*>() ) = static_cast<cl_float> (dTargetTime );
@@ -1327,6 +2724,12 @@ void	CSchemeGodunov::rollbackSimulation( double dCurrentTime, double dTargetTime
 	oclBufferCellStatesAlt->queueWriteAll();
 	oclBufferCellStates->queueWriteAll();
 
+	// The flux kernel may have left entries beyond those tst_Reduce commits,
+	// or a maximum in the atomic slot that was never taken
+	if ( this->bDynamicTimestep && ( this->isReductionFused() || this->isAtomicReductionEnabled() ) )
+		oclBufferTimestepReduction->queueWriteAll();
+	pDomain->getDevice()->queueBarrier();
+
 	// Schedule timestep calculation again
 	// Timestep reduction
 	if ( this->bDynamicTimestep )
@@ -1337,11 +2740,20 @@ void	CSchemeGodunov::rollbackSimulation( double dCurrentTime, double dTargetTime
 
 	// Timestep update without simulation time update
 	if (cModel->getDomainSet()->getSyncMethod() != model::syncMethod::kSyncTimestep)
+	{
 		oclKernelTimestepUpdate->scheduleExecution();
+	}
+	else if ( this->bDynamicTimestep && this->isAtomicReductionEnabled() )
+	{
+		// Nothing takes the maximum from the slot, so empty it for the next iteration
+		pDomain->getDevice()->queueBarrier();
+		oclBufferTimestepReduction->queueWriteAll();
+	}
 	bUseForcedTimeAdvance = true;
 
 	// Clear the failure state
 	oclKernelResetCounters->scheduleExecution();
+	uiBatchSkipped = 0;
 
 	pDomain->getDevice()->queueBarrier();
 	pDomain->getDevice()->flush();
@@ -1450,35 +2862,24 @@ void	CSchemeGodunov::scheduleIteration(
 				CDomain*		pDomain
 )
 {
-	// Re-set the kernel arguments to use the correct cell state buffer
-	// Very carefully watch the index of arguments assignment, there are no safety checks for them
-	if ( bUseAlternateKernel )
-	{
-		oclKernelFullTimestep->assignArgument( 2, oclBufferCellStatesAlt );			// Src
-		oclKernelFullTimestep->assignArgument( 3, oclBufferCellStates );			// Dst
-		if (this->bUseOptimizedBoundary == false) {
-			oclKernelBoundary->assignArgument(3, oclBufferCellStates);					// Dst
-		}else {
-			oclKernelBoundary->assignArgument(3, oclBufferCellStates);					// Dst
-		}
-		oclKernelFriction->assignArgument( 1, oclBufferCellStates );				// Dst
-		oclKernelTimestepReduction->assignArgument( 0, oclBufferCellStates );		// Dst
-	} else {
-		oclKernelFullTimestep->assignArgument( 2, oclBufferCellStates );			// Src
-		oclKernelFullTimestep->assignArgument( 3, oclBufferCellStatesAlt );			// Dst
-		if (this->bUseOptimizedBoundary == false) {
-			oclKernelBoundary->assignArgument(3, oclBufferCellStatesAlt);				// Dst
-		}else {
-			oclKernelBoundary->assignArgument(3, oclBufferCellStatesAlt);				// Dst
-		}
-		oclKernelFriction->assignArgument( 1, oclBufferCellStatesAlt );				// Dst
-		oclKernelTimestepReduction->assignArgument( 0, oclBufferCellStatesAlt );	// Dst
-	}
+	// Pick the kernel instances already holding the correct cell state buffers
+	oclKernelFullTimestep->setAlternate( bUseAlternateKernel );
+	oclKernelBoundary->setAlternate( bUseAlternateKernel );
+	oclKernelFriction->setAlternate( bUseAlternateKernel );
+	oclKernelTimestepReduction->setAlternate( bUseAlternateKernel );
 
 	// Run the boundary kernels (each bndy has its own kernel now)
 	//pDomain->getBoundaries()->applyBoundaries(bUseAlternateKernel ? oclBufferCellStatesAlt : oclBufferCellStates);
 	//pDevice->queueBarrier();
 
+	// Rebuild the active tiles every so often
+	if ( this->isActiveTilesEnabled() )
+	{
+		if ( this->uiIterationsSinceCompaction == 0 )
+			this->scheduleTileCompaction( bUseAlternateKernel, pDevice );
+		this->uiIterationsSinceCompaction = ( this->uiIterationsSinceCompaction + 1 ) % this->uiActiveTilesInterval;
+	}
+
 
 	// Main scheme kernel
 
@@ -1494,16 +2895,19 @@ void	CSchemeGodunov::scheduleIteration(
 		pDevice->queueBarrier();
 	}
 
-	// Boundary Kernel
-	this->cModel->profiler->profile("oclKernelBoundary", CProfiler::profilerFlags::START_PROFILING);
-	oclKernelBoundary->scheduleExecution();
-	pDevice->queueBarrier();
-	this->cModel->profiler->profile("oclKernelBoundary", CProfiler::profilerFlags::END_PROFILING, this->pDomain->getDevice());
+	// Boundary Kernel (unless the flux kernel has applied the rates already)
+	if ( !this->isBoundaryFused() )
+	{
+		this->cModel->profiler->profile("oclKernelBoundary", CProfiler::profilerFlags::START_PROFILING);
+		oclKernelBoundary->scheduleExecution();
+		pDevice->queueBarrier();
+		this->cModel->profiler->profile("oclKernelBoundary", CProfiler::profilerFlags::END_PROFILING, this->pDomain->getDevice());
+	}
 
 
 	this->cModel->profiler->profile("oclKernelTimestepReduction", CProfiler::profilerFlags::START_PROFILING);
-	// Timestep reduction
-	if ( this->bDynamicTimestep )
+	// Timestep reduction (unless the flux kernel has done it already)
+	if ( this->bDynamicTimestep && !this->isReductionFused() )
 	{
 		oclKernelTimestepReduction->scheduleExecution();
 		pDevice->queueBarrier();
@@ -1521,6 +2925,222 @@ void	CSchemeGodunov::scheduleIteration(
 	//pDevice->blockUntilFinished();
 }
 
+/*
+ *  Schedule a batch of iterations as a single launch of the persistent loop,
+ *  which stops early once the target time is reached
+ */
+void	CSchemeGodunov::schedulePersistentLoop(
+				bool			bUseAlternateKernel,
+				unsigned int	uiIterations,
+				COCLDevice*		pDevice
+)
+{
+	*( oclBufferIterationBudget->getHostBlock<cl_uint*>() ) = uiIterations;
+	oclBufferIterationBudget->queueWriteAll();
+
+	oclKernelPersistentLoop->assignArgument( 2, bUseAlternateKernel ? oclBufferCellStatesAlt : oclBufferCellStates );	// Src
+	oclKernelPersistentLoop->assignArgument( 3, bUseAlternateKernel ? oclBufferCellStates : oclBufferCellStatesAlt );	// Dst
+	pDevice->queueBarrier();
+
+	this->cModel->profiler->profile("oclKernelPersistentLoop", CProfiler::profilerFlags::START_PROFILING);
+	oclKernelPersistentLoop->scheduleExecution();
+	pDevice->queueBarrier();
+	this->cModel->profiler->profile("oclKernelPersistentLoop", CProfiler::profilerFlags::END_PROFILING, this->pDomain->getDevice());
+}
+
+/*
+ *  Calculate the timestep from the latest cell states after a sync, which is
+ *  otherwise left to a first iteration with a zero timestep
+ */
+void	CSchemeGodunov::scheduleTimestepResume(
+				bool			bUseAlternateKernel,
+				COCLDevice*		pDevice
+)
+{
+	this->cModel->profiler->profile("oclKernelTimestepResume", CProfiler::profilerFlags::START_PROFILING);
+	if ( this->bDynamicTimestep )
+	{
+		// The flux kernel may have left entries beyond those tst_Reduce commits
+		if ( this->isReductionFused() && !this->isAtomicReductionEnabled() )
+		{
+			oclBufferTimestepReduction->queueWriteAll();
+			pDevice->queueBarrier();
+		}
+
+		// The reduction reads the destination of the instance given, so the
+		// latest states are those of the other instance
+		oclKernelTimestepReduction->setAlternate( !bUseAlternateKernel );
+		oclKernelTimestepReduction->scheduleExecution();
+		pDevice->queueBarrier();
+	}
+	oclKernelTimestepResume->scheduleExecution();
+	pDevice->queueBarrier();
+	this->cModel->profiler->profile("oclKernelTimestepResume", CProfiler::profilerFlags::END_PROFILING, this->pDomain->getDevice());
+}
+
+/*
+ *  Rebuild the list of active tiles from the latest cell states
+ */
+void	CSchemeGodunov::scheduleTileCompaction(
+				bool			bUseAlternateKernel,
+				COCLDevice*		pDevice
+)
+{
+	COCLBuffer*	pBufferLatest	= bUseAlternateKernel ? oclBufferCellStatesAlt : oclBufferCellStates;
+	COCLBuffer*	pBufferOlder	= bUseAlternateKernel ? oclBufferCellStates : oclBufferCellStatesAlt;
+
+	oclKernelTileFlag->assignArgument( 0, pBufferLatest );
+	oclKernelTileSync->assignArgument( 0, pBufferLatest );
+	oclKernelTileSync->assignArgument( 1, pBufferOlder );
+
+	this->cModel->profiler->profile("oclKernelTileCompaction", CProfiler::profilerFlags::START_PROFILING);
+	oclKernelTileFlag->scheduleExecution();
+	pDevice->queueBarrier();
+	if ( this->bUseOptimizedBoundary )
+	{
+		oclKernelTilePin->scheduleExecution();
+		pDevice->queueBarrier();
+	}
+	oclKernelTileCompact->scheduleExecution();
+	pDevice->queueBarrier();
+	oclKernelTileSync->scheduleExecution();
+	pDevice->queueBarrier();
+	this->cModel->profiler->profile("oclKernelTileCompaction", CProfiler::profilerFlags::END_PROFILING, this->pDomain->getDevice());
+}
+
+/*
+ *  Reduce the wet extent of the latest cell states and queue reading it back
+ */
+void	CSchemeGodunov::scheduleWetExtent(
+				bool			bUseAlternateKernel,
+				COCLDevice*		pDevice
+)
+{
+	cl_uint*	uiExtent	= oclBufferWetExtent->getHostBlock<cl_uint*>();
+
+	uiExtent[0] = CL_UINT_MAX;
+	uiExtent[1] = CL_UINT_MAX;
+	uiExtent[2] = 0;
+	uiExtent[3] = 0;
+
+	oclKernelWetExtent->assignArgument( 0, bUseAlternateKernel ? oclBufferCellStatesAlt : oclBufferCellStates );
+
+	this->cModel->profiler->profile("oclKernelWetExtent", CProfiler::profilerFlags::START_PROFILING);
+	oclBufferWetExtent->queueWriteAll();
+	pDevice->queueBarrier();
+	oclKernelWetExtent->scheduleExecution();
+	if ( this->bUseOptimizedBoundary )
+		oclKernelWetExtentCoupling->scheduleExecution();
+	pDevice->queueBarrier();
+	this->cModel->profiler->profile("oclKernelWetExtent", CProfiler::profilerFlags::END_PROFILING, this->pDomain->getDevice());
+
+	// Read back with the batch status, which the batch blocks on before the next batch uses it
+	this->bWetExtentValid = true;
+}
+
+/*
+ *  Size the flux, friction and boundary launches to the box around the wet
+ *  extent, grown by the furthest water can travel over the batch: one cell
+ *  per iteration, plus the dry neighbours the flux kernel has to calculate.
+ */
+void	CSchemeGodunov::applyWetExtent(
+				bool			bUseAlternateKernel,
+				unsigned int	uiIterations,
+				COCLDevice*		pDevice
+)
+{
+	CDomainCartesian*	pDomain		= static_cast<CDomainCartesian*>( this->pDomain );
+	cl_ulong			ulOffsetX	= 0;
+	cl_ulong			ulOffsetY	= 0;
+	cl_ulong			ulEndX		= pDomain->getCols();
+	cl_ulong			ulEndY		= pDomain->getRows();
+
+	if ( this->bWetExtentValid )
+	{
+		cl_uint*	uiExtent	= oclBufferWetExtent->getHostBlock<cl_uint*>();
+		cl_ulong	ulMargin	= static_cast<cl_ulong>( uiIterations ) + 1;
+
+		if ( uiExtent[0] > uiExtent[2] )
+		{
+			// Nothing is wet, but a launch can't be empty
+			ulEndX = 1;
+			ulEndY = 1;
+		} else {
+			ulOffsetX	= uiExtent[0] > ulMargin ? uiExtent[0] - ulMargin : 0;
+			ulOffsetY	= uiExtent[1] > ulMargin ? uiExtent[1] - ulMargin : 0;
+			ulEndX		= min( static_cast<cl_ulong>( uiExtent[2] ) + ulMargin + 1, ulEndX );
+			ulEndY		= min( static_cast<cl_ulong>( uiExtent[3] ) + ulMargin + 1, ulEndY );
+		}
+
+		// Keep the work-groups aligned with those of a full launch
+		ulOffsetX	-= ulOffsetX % this->ulNonCachedWorkgroupSizeX;
+		ulOffsetY	-= ulOffsetY % this->ulNonCachedWorkgroupSizeY;
+	}
+
+	if ( ulOffsetX == this->ulWetBoxOffsetX && ulEndX - ulOffsetX == this->ulWetBoxSizeX &&
+		 ulOffsetY == this->ulWetBoxOffsetY && ulEndY - ulOffsetY == this->ulWetBoxSizeY )
+		return;
+
+	// Cells leaving the box are no longer written, so both state buffers must hold their latest values
+	if ( ulOffsetX > this->ulWetBoxOffsetX || ulEndX < this->ulWetBoxOffsetX + this->ulWetBoxSizeX ||
+		 ulOffsetY > this->ulWetBoxOffsetY || ulEndY < this->ulWetBoxOffsetY + this->ulWetBoxSizeY )
+	{
+		oclKernelWetSync->assignArgument( 0, bUseAlternateKernel ? oclBufferCellStatesAlt : oclBufferCellStates );
+		oclKernelWetSync->assignArgument( 1, bUseAlternateKernel ? oclBufferCellStates : oclBufferCellStatesAlt );
+		oclKernelWetSync->setGlobalOffset( this->ulWetBoxOffsetX, this->ulWetBoxOffsetY );
+		oclKernelWetSync->setGlobalSize( this->ulWetBoxSizeX, this->ulWetBoxSizeY );
+		oclKernelWetSync->scheduleExecution();
+
+		// Fewer work-groups will now write their entries in the fused reduction
+		if ( this->isReductionFused() )
+			oclBufferTimestepReduction->queueWriteAll();
+
+		pDevice->queueBarrier();
+	}
+
+	this->ulWetBoxOffsetX	= ulOffsetX;
+	this->ulWetBoxOffsetY	= ulOffsetY;
+	this->ulWetBoxSizeX		= ulEndX - ulOffsetX;
+	this->ulWetBoxSizeY		= ulEndY - ulOffsetY;
+
+	oclKernelFullTimestep->setGlobalOffset( this->ulWetBoxOffsetX, this->ulWetBoxOffsetY );
+	oclKernelFullTimestep->setGlobalSize( this->ulWetBoxSizeX, this->ulWetBoxSizeY );
+	oclKernelFriction->setGlobalOffset( this->ulWetBoxOffsetX, this->ulWetBoxOffsetY );
+	oclKernelFriction->setGlobalSize( this->ulWetBoxSizeX, this->ulWetBoxSizeY );
+	if ( !this->bUseOptimizedBoundary )
+	{
+		oclKernelBoundary->setGlobalOffset( this->ulWetBoxOffsetX, this->ulWetBoxOffsetY );
+		oclKernelBoundary->setGlobalSize( this->ulWetBoxSizeX, this->ulWetBoxSizeY );
+	}
+}
+
+/*
+ *  Write the boundary values imported from the link zones to the device
+ */
+void CSchemeGodunov::scheduleBoundaryWrite( COCLDevice* pDevice )
+{
+	if (this->bUseOptimizedBoundary == false) {
+		this->oclBufferCellBoundary->queueWriteAll();
+	}
+	else {
+		this->oclBufferCouplingValues->queueWriteAll();
+		if ( this->isBoundaryFused() )
+		{
+			pDevice->queueBarrier();
+			this->oclKernelBoundaryScatter->scheduleExecution();
+		}
+	}
+}
+
+/*
+ *  Bytes of status the scheme itself keeps in the batch status block, which
+ *  is read back with the time, timestep and counters after every batch
+ */
+cl_ulong	CSchemeGodunov::getBatchStatusExtraSize()
+{
+	return 0;
+}
+
 /*
  *  Read back all of the domain data
  */
@@ -1537,6 +3157,24 @@ void CSchemeGodunov::readDomainAll()
 	this->cModel->profiler->profile("readDomainAll", CProfiler::profilerFlags::END_PROFILING, this->pDomain->getDevice());
 }
 
+/*
+ *  Read back the free-surface levels only, which are the first of the four
+ *  arrays when the cell states are held as a structure of arrays
+ */
+void CSchemeGodunov::readDomainFSL()
+{
+	if ( !this->isCellStateSoAEnabled() )
+	{
+		this->readDomainAll();
+		return;
+	}
+
+	this->cModel->profiler->profile("readDomainAll", CProfiler::profilerFlags::START_PROFILING);
+	COCLBuffer* pBufferLatest = bUseAlternateKernel ? oclBufferCellStatesAlt : oclBufferCellStates;
+	pBufferLatest->queueReadPartial( 0, this->pDomain->getCellCount() * ( this->pDomain->isDoublePrecision() ? sizeof( cl_double ) : sizeof( cl_float ) ) );
+	this->cModel->profiler->profile("readDomainAll", CProfiler::profilerFlags::END_PROFILING, this->pDomain->getDevice());
+}
+
 /*
  *  Read back domain data for the synchronisation zones only
  */
@@ -1672,7 +3310,7 @@ void	CSchemeGodunov::readKeyStatistics()
 	cl_uint uiLastBatchSuccessful = uiBatchSuccessful;
 
 	// Pull key data back from our buffers to the scheme class
-	if (cModel->getFloatPrecision() == model::floatPrecision::kSingle )
+	if (cModel->getFloatPrecision() != model::floatPrecision::kDouble )
 	{
 		dCurrentTimestep = static_cast<cl_double>( *( oclBufferTimestep->getHostBlock<float*>() ) );
 		dCurrentTime = static_cast<cl_double>(*(oclBufferTime->getHostBlock<float*>()));
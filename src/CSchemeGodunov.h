@@ -57,6 +57,40 @@ class CSchemeGodunov : public CScheme
 		unsigned char		getCacheMode();											// Get the cache configuration
 		void				setCacheConstraints( unsigned char );					// Set LDS cache size constraints
 		unsigned char		getCacheConstraints();									// Get LDS cache size constraints
+		void				setReductionInFluxKernel( bool );						// Set the timestep reduction to run in the flux kernel
+		bool				getReductionInFluxKernel();								// Get whether the timestep reduction runs in the flux kernel
+		void				setBoundaryInFluxKernel( bool );						// Set the boundary rates to be applied in the flux kernel
+		bool				getBoundaryInFluxKernel();								// Get whether the boundary rates are applied in the flux kernel
+		void				setActiveTiles( bool );									// Set whether only active tiles are calculated
+		bool				getActiveTiles();										// Get whether only active tiles are calculated
+		void				setActiveTilesInterval( unsigned int );					// Set the iterations between active tile rebuilds
+		unsigned int		getActiveTilesInterval();								// Get the iterations between active tile rebuilds
+		void				setWetExtent( bool );									// Set whether launches are shrunk to the wet extent
+		bool				getWetExtent();											// Get whether launches are shrunk to the wet extent
+		void				setCellStateSoA( bool );								// Set whether cell states are held as four arrays
+		bool				getCellStateSoA();										// Get whether cell states are held as four arrays
+		void				setMixedPrecision( bool );								// Set whether static data is held in single precision
+		bool				getMixedPrecision();									// Get whether static data is held in single precision
+		void				setDepthEncoding( bool );								// Set whether levels are stored as depths
+		bool				getDepthEncoding();										// Get whether levels are stored as depths
+		void				setCellTileRows( unsigned int );						// Set the height of the strips cells are tiled in
+		unsigned int		getCellTileRows();										// Get the height of the strips cells are tiled in
+		void				setTemporalBlockSteps( unsigned int );					// Set the timesteps advanced per flux kernel launch
+		unsigned int		getTemporalBlockSteps();								// Get the timesteps advanced per flux kernel launch
+		void				setStripCells( unsigned int );							// Set the cells each flux work-item walks up
+		unsigned int		getStripCells();										// Get the cells each flux work-item walks up
+		void				setStaticImages( bool );								// Set whether bed and Manning are read as images
+		bool				getStaticImages();										// Get whether bed and Manning are read as images
+		void				setPersistentLoop( bool );								// Set whether a batch runs from a single launch
+		bool				getPersistentLoop();									// Get whether a batch runs from a single launch
+		void				setAtomicReduction( bool );								// Set whether the timestep reduction ends in an atomic max
+		bool				getAtomicReduction();									// Get whether the timestep reduction ends in an atomic max
+		void				setOutOfOrderQueue( bool );								// Set whether the device queue executes out of order
+		bool				getOutOfOrderQueue();									// Get whether the device queue executes out of order
+		void				setAutotune( bool );									// Set whether the execution dimensions are tuned
+		bool				getAutotune();											// Get whether the execution dimensions are tuned
+		void				setAutotuneCache( std::string );						// Set the file holding tuned execution dimensions
+		std::string			getAutotuneCache();										// Get the file holding tuned execution dimensions
 		void				setCachedWorkgroupSize( unsigned char );				// Set the work-group size
 		void				setCachedWorkgroupSize( unsigned char, unsigned char );	// Set the work-group size
 		void				setNonCachedWorkgroupSize( unsigned char );				// Set the work-group size
@@ -73,6 +107,7 @@ class CSchemeGodunov : public CScheme
 		void				Threaded_runBatch();
 
 		virtual void		readDomainAll();										// Read back all domain data
+		virtual void		readDomainFSL();										// Read back the free-surface levels
 		virtual void		importLinkZoneData();									// Load in data
 		virtual void		prepareSimulation();									// Set everything up to start running for this domain
 		virtual void		readKeyStatistics();									// Fetch the key details back to the right places in memory
@@ -96,6 +131,14 @@ class CSchemeGodunov : public CScheme
 		cl_ulong			ulBoundaryCellGlobalSize;
 		cl_ulong			ulReductionWorkgroupSize;
 		cl_ulong			ulReductionGlobalSize;
+		cl_ulong			ulActiveTilesX, ulActiveTilesY;
+		cl_ulong			ulWetBoxOffsetX, ulWetBoxOffsetY;
+		cl_ulong			ulWetBoxSizeX, ulWetBoxSizeY;
+		cl_ulong			ulTemporalBlockGlobalSizeX, ulTemporalBlockGlobalSizeY;
+		cl_ulong			ulStripGlobalSizeY;
+		cl_ulong			ulBatchStatusReadSize;									// Bytes of the batch status block read back per batch
+		cl_ulong			ulBatchStatusStride;									// Alignment of each entry in the batch status block
+		cl_ulong			ulBatchStatusExtraOffset;								// Start of the scheme's own status in the batch status block
 
 		unsigned char		ucConfiguration;										// Kernel configuration in-use
 		unsigned char		ucCacheConstraints;										// Kernel LDS cache constraints
@@ -106,6 +149,22 @@ class CSchemeGodunov : public CScheme
 		double				dLastSyncTime;											// What was the last synchronisation time?
 		bool				bDebugOutput;											// Debug output enabled in the scheme?
 		bool				bFrictionInFluxKernel;									// Process friction in the flux kernel?
+		bool				bReductionInFluxKernel;									// Reduce the timestep in the flux kernel?
+		bool				bBoundaryInFluxKernel;									// Apply boundary rates in the flux kernel?
+		bool				bActiveTiles;											// Only calculate active (wet) tiles?
+		bool				bWetExtent;												// Shrink the launches to the wet extent?
+		bool				bWetExtentValid;										// Is the wet extent read back still current?
+		bool				bCellStateSoA;											// Hold the cell states as four arrays?
+		bool				bMixedPrecision;										// Hold static data in single precision?
+		bool				bDepthEncoding;											// Store levels as depths above the bed?
+		bool				bPersistentLoop;										// Run each batch from a single launch?
+		bool				bStaticImages;											// Read the bed and Manning values as images?
+		bool				bAtomicReduction;										// End the timestep reduction in an atomic max?
+		bool				bOutOfOrderQueue;										// Execute the device queue out of order?
+		bool				bAutotune;												// Tune the execution dimensions for the device?
+		bool				bAutotuning;											// Is a candidate being built for tuning?
+		bool				bAutotuneCached;										// Are tuned execution dimensions in use?
+		std::string			sAutotuneCache;											// File holding tuned execution dimensions
 		bool				bUseAlternateKernel;									// Use the alternate kernel configurations (for memory)
 		bool				bUseForcedTimeAdvance;									// Force the timestep to be advanced next time?
 		bool				bOverrideTimestep;										// Force set the timestep next time?
@@ -117,6 +176,11 @@ class CSchemeGodunov : public CScheme
 		unsigned int		uiDebugCellX;											// Debug info cell X
 		unsigned int		uiDebugCellY;											// Debug info cell Y
 		unsigned int		uiTimestepReductionWavefronts;							// Number of wavefronts used in reduction
+		unsigned int		uiActiveTilesInterval;									// Iterations between active tile rebuilds
+		unsigned int		uiCellTileRows;											// Height of the strips cells are tiled in
+		unsigned int		uiTemporalBlockSteps;									// Timesteps advanced per flux kernel launch
+		unsigned int		uiStripCells;											// Cells each flux work-item walks up
+		unsigned int		uiIterationsSinceCompaction;							// Iterations since the active tiles were rebuilt
 		cl_double4*			dBoundaryTimeSeries;									// Boundary time series data
 		cl_float4*			fBoundaryTimeSeries;									// Boundary time series data
 		cl_ulong*			ulBoundaryRelationCells;								// Boundary to cell relations
@@ -128,9 +192,53 @@ class CSchemeGodunov : public CScheme
 		virtual void		releaseResources();										// Release OpenCL resources consumed
 		bool				prepareGeneralKernels();								// Prepare the general kernels required
 		bool				prepare1OKernels();										// Prepare the kernels required
+		virtual bool		prepareAlternateKernels();								// Prepare the kernels with source and destination swapped
 		bool				prepare1OConstants();									// Assign constants to the executor
 		bool				prepare1OMemory();										// Prepare memory buffers required
 		bool				prepare1OExecDimensions();								// Size the problem for execution
+		bool				isReductionFused();										// Is the timestep reduction carried out by the flux kernel?
+		bool				isBoundaryFused();										// Are the boundary rates applied by the flux kernel?
+		COCLBuffer*			getBoundaryRateBuffer();								// Get the per-cell boundary rates for the flux kernel
+		bool				isActiveTilesEnabled();									// Are the kernels restricted to active tiles?
+		void				scheduleTileCompaction( bool, COCLDevice* );			// Rebuild the list of active tiles
+		bool				isWetExtentEnabled();									// Are the launches shrunk to the wet extent?
+		void				scheduleWetExtent( bool, COCLDevice* );					// Reduce and read back the wet extent
+		void				applyWetExtent( bool, unsigned int, COCLDevice* );		// Size the launches to the wet extent
+		bool				isCellStateSoAEnabled();								// Are the cell states held as four arrays?
+		bool				isMixedPrecisionEnabled();								// Is static data held in single precision?
+		unsigned char		getStaticFloatSize();									// Size of floats used for static data (bytes)
+		bool				isDepthEncodingEnabled();								// Are levels actually stored as depths?
+		virtual bool		isDoubleFloatEnabled();									// Is the state update emulated as double-float?
+		bool				isCellTilingEnabled();									// Are the cells tiled in strips?
+		virtual bool		isTemporalBlockingEnabled();							// Does the flux kernel advance several timesteps?
+		bool				isTemporalBlockingPossible();							// Could the flux kernel advance several timesteps?
+		unsigned int		getStepsPerIteration();									// Timesteps advanced per scheduled iteration
+		virtual bool		isStripMiningEnabled();									// Does each flux work-item walk up a strip of cells?
+		bool				isStripMiningPossible();								// Could each flux work-item walk up a strip of cells?
+		virtual bool		isStaticImagesEnabled();								// Are the bed and Manning values read as images?
+		bool				isStaticImagesPossible();								// Could the bed and Manning values be read as images?
+		virtual bool		isManningImageEnabled();								// Does the flux kernel read the Manning values as an image?
+		COCLBuffer*			getStaticBedBuffer();									// Get the bed elevations for the non-cached flux kernel
+		COCLBuffer*			getStaticManningBuffer();								// Get the Manning values for the non-cached flux kernel
+		virtual bool		isZeroTimestepSkipEnabled();							// Are zero-timestep iterations skipped without a copy?
+		void				scheduleTimestepResume( bool, COCLDevice* );			// Restart a zero timestep from the latest states
+		virtual bool		isPersistentLoopEnabled();								// Does each batch run from a single launch?
+		bool				isPersistentLoopPossible();								// Could each batch run from a single launch?
+		void				schedulePersistentLoop( bool, unsigned int, COCLDevice* );	// Schedule a batch of iterations as a single launch
+		virtual void		scheduleBoundaryWrite( COCLDevice* );					// Write the imported boundary values to the device
+		virtual cl_ulong	getBatchStatusExtraSize();								// Bytes of the scheme's own status read back per batch
+		bool				isAtomicReductionEnabled();								// Does the timestep reduction end in an atomic max?
+		bool				isAtomicReduction64();									// Are the speeds in the atomic reduction 64-bit?
+		bool				isSubgroupReductionEnabled();							// Are work-groups reduced with sub-group built-ins?
+		std::string			getReductionDescription();								// Describe the timestep reduction for the log
+		bool				prepareCommandQueue();									// Switch the device queue to the requested mode
+		bool				isAutotuneEnabled();									// Are the execution dimensions tuned?
+		virtual std::string	getAutotuneScheme();									// Scheme name used in the tuning cache key
+		virtual std::string	getAutotuneKey();										// Tuning cache key for this device and scheme
+		bool				readAutotuneCache();									// Load tuned execution dimensions
+		void				writeAutotuneCache();									// Store tuned execution dimensions
+		double				timeAutotuneCandidate();								// Build and time one candidate configuration
+		bool				autotuneExecDimensions();								// Tune the execution dimensions if required
 		void				release1OResources();									// Release 1st-order OpenCL resources consumed
 
 		// OpenCL elements
@@ -142,18 +250,34 @@ class CSchemeGodunov : public CScheme
 		COCLKernel*			oclKernelTimeAdvance;
 		COCLKernel*			oclKernelResetCounters;
 		COCLKernel*			oclKernelTimestepUpdate;
+		COCLKernel*			oclKernelTimestepResume;
+		COCLKernel*			oclKernelBoundaryScatter;
+		COCLKernel*			oclKernelTileFlag;
+		COCLKernel*			oclKernelTilePin;
+		COCLKernel*			oclKernelTileCompact;
+		COCLKernel*			oclKernelTileSync;
+		COCLKernel*			oclKernelWetExtent;
+		COCLKernel*			oclKernelWetExtentCoupling;
+		COCLKernel*			oclKernelWetSync;
+		COCLKernel*			oclKernelPersistentLoop;
 		COCLBuffer*			oclBufferCellStates;
 		COCLBuffer*			oclBufferCellStatesAlt;
 		COCLBuffer*			oclBufferCellManning;
 		COCLBuffer*			oclBufferCellBoundary;
 		COCLBuffer*			oclBufferCouplingIDs;
 		COCLBuffer*			oclBufferCouplingValues;
-		COCLBuffer*			oclBufferUsePoleni;
-		COCLBuffer*			oclBuffer_opt_zxmax;
-		COCLBuffer*			oclBuffer_opt_cx;
-		COCLBuffer*			oclBuffer_opt_zymax;
-		COCLBuffer*			oclBuffer_opt_cy;
+		COCLBuffer*			oclBufferBoundaryRates;
+		COCLBuffer*			oclBufferTileFlags;
+		COCLBuffer*			oclBufferActiveTiles;
+		COCLBuffer*			oclBufferWetExtent;
+		COCLBuffer*			oclBufferIterationBudget;
+		COCLBuffer*			oclBufferPoleniMasks;
+		COCLBuffer*			oclBufferWeirFaceIDs;
+		COCLBuffer*			oclBufferWeirFaceValues;
+		COCLBuffer*			oclBufferCellFSLLow;
 		COCLBuffer*			oclBufferCellBed;
+		COCLBuffer*			oclBufferCellBedImage;
+		COCLBuffer*			oclBufferCellManningImage;
 		COCLBuffer*			oclBufferTimestep;
 		COCLBuffer*			oclBufferTime;
 		COCLBuffer*			oclBufferTimeTarget;
@@ -162,6 +286,7 @@ class CSchemeGodunov : public CScheme
 		COCLBuffer*			oclBufferBatchTimesteps;
 		COCLBuffer*			oclBufferBatchSuccessful;
 		COCLBuffer*			oclBufferBatchSkipped;
+		COCLBuffer*			oclBufferBatchStatus;
 
 };
 
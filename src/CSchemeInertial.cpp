@@ -72,8 +72,14 @@ void CSchemeInertial::prepareAll()
 	this->dCurrentTime = 0;
 
 	// Forcing single precision?
-	this->oclModel->setForcedSinglePrecision(cModel->getFloatPrecision() == model::floatPrecision::kSingle);
-	unsigned char ucFloatSize = (cModel->getFloatPrecision() == model::floatPrecision::kSingle ? sizeof(cl_double) : sizeof(cl_float));
+	this->oclModel->setForcedSinglePrecision(cModel->getFloatPrecision() != model::floatPrecision::kDouble);
+	this->oclModel->setSubGroups( this->isSubgroupReductionEnabled() );
+	if (!this->prepareCommandQueue())
+	{
+		this->releaseResources();
+		return;
+	}
+	unsigned char ucFloatSize = (cModel->getFloatPrecision() != model::floatPrecision::kDouble ? sizeof(cl_double) : sizeof(cl_float));
 
 	// OpenCL elements
 	if (!this->prepare1OExecDimensions())
@@ -135,7 +141,7 @@ void CSchemeInertial::prepareAll()
 		this->releaseResources();
 		return;
 	}
-	if (!this->prepareInertialKernels())
+	if (!this->prepareInertialKernels() || !this->prepareAlternateKernels())
 	{
 		model::doError(
 			"Failed to prepare inertial kernels. Cannot continue.",
@@ -145,7 +151,6 @@ void CSchemeInertial::prepareAll()
 		return;
 	}
 
-
 	this->logDetails();
 	this->bReady = true;
 }
@@ -173,10 +178,21 @@ void CSchemeInertial::logDetails()
 	model::log->writeLine("  Timestep mode:      " + (std::string)(this->bDynamicTimestep ? "Dynamic" : "Fixed"), true, wColour);
 	model::log->writeLine("  Courant number:     " + (std::string)(this->bDynamicTimestep ? toStringExact(this->dCourantNumber) : "N/A"), true, wColour);
 	model::log->writeLine("  Initial timestep:   " + Util::secondsToTime(this->dTimestep), true, wColour);
-	model::log->writeLine("  Data reduction:     " + toStringExact(this->uiTimestepReductionWavefronts) + " divisions", true, wColour);
+	model::log->writeLine("  Data reduction:     " + this->getReductionDescription(), true, wColour);
 	model::log->writeLine("  Configuration:      " + sConfiguration, true, wColour);
+	model::log->writeLine("  Fused reduction:    " + (std::string)(this->isReductionFused() ? "Enabled" : "Disabled"), true, wColour);
+	model::log->writeLine("  Fused boundaries:   " + (std::string)(this->isBoundaryFused() ? "Enabled" : "Disabled"), true, wColour);
+	model::log->writeLine("  Active tiles:       " + (std::string)(this->isActiveTilesEnabled() ? "Rebuilt every " + toStringExact(this->uiActiveTilesInterval) + " iteration(s)" : "Disabled"), true, wColour);
+	model::log->writeLine("  Wet extent launch:  " + (std::string)(this->isWetExtentEnabled() ? "Enabled" : "Disabled"), true, wColour);
+	model::log->writeLine("  Cell state layout:  " + (std::string)(this->isCellStateSoAEnabled() ? "Structure of arrays" : "Array of structures"), true, wColour);
+	model::log->writeLine("  Static data:        " + (std::string)(this->getStaticFloatSize() == sizeof(cl_float) ? "Single-precision" : "Double-precision"), true, wColour);
+	model::log->writeLine("  Stored levels:      " + (std::string)(this->isDepthEncodingEnabled() ? "Depth above bed" : "Free-surface level"), true, wColour);
+	model::log->writeLine("  Cell ordering:      " + (std::string)(this->isCellTilingEnabled() ? "Strips of " + toStringExact(this->uiCellTileRows) + " rows" : "Row-major"), true, wColour);
+	model::log->writeLine("  Temporal blocking:  " + (std::string)(this->isTemporalBlockingEnabled() ? toStringExact(this->uiTemporalBlockSteps) + " steps per launch" : "Disabled"), true, wColour);
+	model::log->writeLine("  Work-group size:    " + toStringExact(this->ulNonCachedWorkgroupSizeX) + "x" + toStringExact(this->ulNonCachedWorkgroupSizeY) + (std::string)(this->bAutotuneCached ? " (Tuned)" : ""), true, wColour);
 	model::log->writeLine("  Friction effects:   " + (std::string)(this->bFrictionEffects ? "Enabled" : "Disabled"), true, wColour);
 	model::log->writeLine("  Kernel queue mode:  " + (std::string)(this->bAutomaticQueue ? "Automatic" : "Fixed size"), true, wColour);
+	model::log->writeLine("  Command queue:      " + (std::string)(this->pDomain->getDevice()->isOutOfOrderQueue() ? "Out-of-order" : "In-order"), true, wColour);
 	model::log->writeLine((std::string)(this->bAutomaticQueue ? "  Initial queue:      " : "  Fixed queue:        ") + toStringExact(this->uiQueueAdditionSize) + " iteration(s)", true, wColour);
 	model::log->writeLine("  Debug output:       " + (std::string)(this->bDebugOutput ? "Enabled" : "Disabled"), true, wColour);
 
@@ -251,12 +267,20 @@ bool CSchemeInertial::prepareInertialKernels()
 	// Inertial scheme kernels
 	// --
 
-	if ( this->ucConfiguration == model::schemeConfigurations::inertialFormula::kCacheNone )
+	if ( this->isTemporalBlockingEnabled() )
+	{
+		oclKernelFullTimestep = oclModel->getKernel( "ine_temporalBlock" );
+		oclKernelFullTimestep->setGroupSize( this->ulNonCachedWorkgroupSizeX, this->ulNonCachedWorkgroupSizeY );
+		oclKernelFullTimestep->setGlobalSize( this->ulTemporalBlockGlobalSizeX, this->ulTemporalBlockGlobalSizeY );
+		COCLBuffer* aryArgsFullTimestep[] = { oclBufferTimestep, oclBufferCellBed, oclBufferCellStates, oclBufferCellStatesAlt, oclBufferCellManning, oclBufferPoleniMasks, oclBufferWeirFaceIDs, oclBufferWeirFaceValues, this->getBoundaryRateBuffer() };
+		oclKernelFullTimestep->assignArguments( aryArgsFullTimestep );
+	}
+	else if ( this->ucConfiguration == model::schemeConfigurations::inertialFormula::kCacheNone )
 	{
 		oclKernelFullTimestep = oclModel->getKernel( "ine_cacheDisabled" );
 		oclKernelFullTimestep->setGroupSize( this->ulNonCachedWorkgroupSizeX, this->ulNonCachedWorkgroupSizeY );
 		oclKernelFullTimestep->setGlobalSize( this->ulNonCachedGlobalSizeX, this->ulNonCachedGlobalSizeY );
-		COCLBuffer* aryArgsFullTimestep[] = { oclBufferTimestep, oclBufferCellBed, oclBufferCellStates, oclBufferCellStatesAlt, oclBufferCellManning, oclBufferUsePoleni, oclBuffer_opt_zxmax, oclBuffer_opt_cx, oclBuffer_opt_zymax, oclBuffer_opt_cy };
+		COCLBuffer* aryArgsFullTimestep[] = { oclBufferTimestep, oclBufferCellBed, oclBufferCellStates, oclBufferCellStatesAlt, oclBufferCellManning, oclBufferPoleniMasks, oclBufferWeirFaceIDs, oclBufferWeirFaceValues, oclBufferTimestepReduction, this->getBoundaryRateBuffer(), oclBufferActiveTiles };
 		oclKernelFullTimestep->assignArguments( aryArgsFullTimestep );
 	}
 	if ( this->ucConfiguration == model::schemeConfigurations::inertialFormula::kCacheEnabled )
@@ -327,3 +351,56 @@ unsigned char	CSchemeInertial::getCacheConstraints()
 {
 	return this->ucCacheConstraints;
 }
+
+/*
+ *  The inertial kernels don't carry the low-order part of the levels, so
+ *  double-float runs as plain single precision
+ */
+bool	CSchemeInertial::isDoubleFloatEnabled()
+{
+	return false;
+}
+
+/*
+ *  Does the flux kernel advance several timesteps?
+ */
+bool	CSchemeInertial::isTemporalBlockingEnabled()
+{
+	return this->ucConfiguration == model::schemeConfigurations::inertialFormula::kCacheNone &&
+		   this->isTemporalBlockingPossible();
+}
+
+/*
+ *  Does each flux work-item walk up a strip of cells? The inertial kernels
+ *  have no strip-mined variant.
+ */
+bool	CSchemeInertial::isStripMiningEnabled()
+{
+	return false;
+}
+
+/*
+ *  Are the bed elevations and Manning values read as images? The inertial
+ *  kernels only read buffers.
+ */
+bool	CSchemeInertial::isStaticImagesEnabled()
+{
+	return false;
+}
+
+/*
+ *  Are zero-timestep iterations skipped without a copy? The inertial
+ *  kernels still copy the cells across.
+ */
+bool	CSchemeInertial::isZeroTimestepSkipEnabled()
+{
+	return false;
+}
+
+/*
+ *  Scheme name used in the tuning cache key
+ */
+std::string	CSchemeInertial::getAutotuneScheme()
+{
+	return "Inertial";
+}
@@ -53,6 +53,12 @@ class CSchemeInertial : public CSchemeGodunov
 		bool				prepareInertialKernels();						// Prepare the kernels required
 		bool				prepareInertialConstants();						// Assign constants to the executor
 		void				releaseInertialResources();						// Release OpenCL resources consumed
+		virtual bool		isDoubleFloatEnabled();							// Is the state update emulated as double-float?
+		virtual bool		isTemporalBlockingEnabled();					// Does the flux kernel advance several timesteps?
+		virtual bool		isStripMiningEnabled();							// Does each flux work-item walk up a strip of cells?
+		virtual bool		isStaticImagesEnabled();						// Are the bed and Manning values read as images?
+		virtual bool		isZeroTimestepSkipEnabled();					// Are zero-timestep iterations skipped without a copy?
+		virtual std::string	getAutotuneScheme();							// Scheme name used in the tuning cache key
 
 };
 
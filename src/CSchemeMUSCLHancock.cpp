@@ -103,7 +103,13 @@ void CSchemeMUSCLHancock::prepareAll()
 	this->dCurrentTime = 0;
 
 	// Forcing single precision?
-	this->oclModel->setForcedSinglePrecision(cModel->getFloatPrecision() == model::floatPrecision::kSingle);
+	this->oclModel->setForcedSinglePrecision(cModel->getFloatPrecision() != model::floatPrecision::kDouble);
+	this->oclModel->setSubGroups( this->isSubgroupReductionEnabled() );
+	if (!this->prepareCommandQueue())
+	{
+		this->releaseResources();
+		return;
+	}
 	unsigned char ucFloatSize = (cModel->getFloatPrecision() == model::floatPrecision::kDouble ? sizeof(cl_double) : sizeof(cl_float));
 
 	// OpenCL elements
@@ -231,11 +237,12 @@ void CSchemeMUSCLHancock::logDetails()
 	model::log->writeLine("  Timestep mode:      " + (std::string)(this->bDynamicTimestep ? "Dynamic" : "Fixed"), true, wColour);
 	model::log->writeLine("  Courant number:     " + (std::string)(this->bDynamicTimestep ? toStringExact(this->dCourantNumber) : "N/A"), true, wColour);
 	model::log->writeLine("  Initial timestep:   " + Util::secondsToTime(this->dTimestep), true, wColour);
-	model::log->writeLine("  Data reduction:     " + toStringExact(this->uiTimestepReductionWavefronts) + " divisions", true, wColour);
+	model::log->writeLine("  Data reduction:     " + this->getReductionDescription(), true, wColour);
 	model::log->writeLine("  Riemann solver:     " + sSolver, true, wColour);
 	model::log->writeLine("  Configuration:      " + sConfiguration, true, wColour);
 	model::log->writeLine("  Friction effects:   " + (std::string)(this->bFrictionEffects ? "Enabled" : "Disabled"), true, wColour);
 	model::log->writeLine("  Kernel queue mode:  " + (std::string)(this->bAutomaticQueue ? "Automatic" : "Fixed size"), true, wColour);
+	model::log->writeLine("  Command queue:      " + (std::string)(this->pDomain->getDevice()->isOutOfOrderQueue() ? "Out-of-order" : "In-order"), true, wColour);
 	model::log->writeLine((std::string)(this->bAutomaticQueue ? "  Initial queue:      " : "  Fixed queue:        ") + toStringExact(this->uiQueueAdditionSize) + " iteration(s)", true, wColour);
 	model::log->writeLine("  Debug output:       " + (std::string)(this->bDebugOutput ? "Enabled" : "Disabled"), true, wColour);
 
@@ -41,6 +41,38 @@ CSchemePromaides::CSchemePromaides(void)
 
 	this->ucConfiguration				= model::schemeConfigurations::promaidesFormula::kCacheNone;
 	this->ucCacheConstraints			= model::cacheConstraints::promaidesFormula::kCacheActualSize;
+
+	oclKernelFaceFluxes					= NULL;
+	oclKernelPoleniFaces				= NULL;
+	oclBufferFaceFluxes					= NULL;
+	oclBufferWeirFaceFluxes				= NULL;
+	oclKernelFaceConductances			= NULL;
+	oclBufferFaceConductances			= NULL;
+	oclKernelPackedCells				= NULL;
+	oclKernelPackedAdvance				= NULL;
+	oclBufferPackStates					= NULL;
+	oclBufferPackStatesAlt				= NULL;
+	oclBufferPackBed					= NULL;
+	oclBufferPackManning				= NULL;
+	oclBufferPackBoundary				= NULL;
+	oclBufferPackOffsets				= NULL;
+	oclBufferPackDims					= NULL;
+	oclBufferPackResolution				= NULL;
+	oclBufferPackTime					= NULL;
+	oclBufferPackTimestep				= NULL;
+	oclBufferPackTimeHydrological		= NULL;
+	oclBufferPackBatchTimesteps			= NULL;
+	oclBufferPackBatchSuccessful		= NULL;
+	oclBufferPackBatchSkipped			= NULL;
+	oclBufferPackReduction				= NULL;
+
+	this->pPackLeader					= NULL;
+	this->ulPackCellCount				= 0;
+	this->ulPackOffset					= 0;
+	this->pPackCellStates				= NULL;
+	this->pPackBedElevations			= NULL;
+	this->pPackManningValues			= NULL;
+	this->pPackBoundaryValues			= NULL;
 }
 
 /*
@@ -57,6 +89,13 @@ CSchemePromaides::~CSchemePromaides(void)
  */
 void CSchemePromaides::prepareAll()
 {
+	// Packed floodplains only need their host data, the leader does the rest
+	if ( this->pPackLeader != NULL )
+	{
+		this->preparePackedGuest();
+		return;
+	}
+
 	// Clean any pre-existing OpenCL objects
 	this->releaseResources();
 
@@ -71,8 +110,15 @@ void CSchemePromaides::prepareAll()
 	this->dCurrentTime = 0;
 
 	// Forcing single precision?
-	this->oclModel->setForcedSinglePrecision(cModel->getFloatPrecision() == model::floatPrecision::kSingle);
-	unsigned char ucFloatSize = (cModel->getFloatPrecision() == model::floatPrecision::kSingle ? sizeof(cl_double) : sizeof(cl_float));
+	this->oclModel->setForcedSinglePrecision(cModel->getFloatPrecision() != model::floatPrecision::kDouble);
+	this->oclModel->setSubGroups( this->isSubgroupReductionEnabled() );
+	if (!this->prepareCommandQueue())
+	{
+		this->releaseResources();
+		return;
+	}
+	this->oclModel->setDoubleFloat(this->isDoubleFloatEnabled());
+	unsigned char ucFloatSize = (cModel->getFloatPrecision() != model::floatPrecision::kDouble ? sizeof(cl_double) : sizeof(cl_float));
 
 	// OpenCL elements
 	if (!this->prepare1OExecDimensions())
@@ -95,6 +141,16 @@ void CSchemePromaides::prepareAll()
 		return;
 	}
 
+	if (!this->preparePromaidesConstants())
+	{
+		model::doError(
+			"Failed to allocate promaides constants. Cannot continue.",
+			model::errorCodes::kLevelModelStop
+		);
+		this->releaseResources();
+		return;
+	}
+
 	if (!this->prepareCode())
 	{
 		model::doError(
@@ -115,6 +171,16 @@ void CSchemePromaides::prepareAll()
 		return;
 	}
 
+	if (!this->preparePromaidesMemory())
+	{
+		model::doError(
+			"Failed to create promaides memory buffers. Cannot continue.",
+			model::errorCodes::kLevelModelStop
+		);
+		this->releaseResources();
+		return;
+	}
+
 	if (!this->prepareGeneralKernels())
 	{
 		model::doError(
@@ -124,7 +190,7 @@ void CSchemePromaides::prepareAll()
 		this->releaseResources();
 		return;
 	}
-	if (!this->preparePromaidesKernels())
+	if (!this->preparePromaidesKernels() || !this->prepareAlternateKernels())
 	{
 		model::doError(
 			"Failed to prepare promaides kernels. Cannot continue.",
@@ -134,7 +200,6 @@ void CSchemePromaides::prepareAll()
 		return;
 	}
 
-
 	this->logDetails();
 	this->bReady = true;
 }
@@ -148,6 +213,7 @@ void CSchemePromaides::logDetails()
 	unsigned short wColour = model::cli::colourInfoBlock;
 
 	std::string sConfiguration = "Undefined";
+	std::string sPoleniFaces = "None";
 	switch (this->ucConfiguration)
 	{
 	case model::schemeConfigurations::promaidesFormula::kCacheNone:
@@ -156,16 +222,45 @@ void CSchemePromaides::logDetails()
 	case model::schemeConfigurations::promaidesFormula::kCacheEnabled:
 		sConfiguration = "Enabled";
 		break;
+	case model::schemeConfigurations::promaidesFormula::kFaceCentred:
+		sConfiguration = "Face-centred";
+		break;
+	}
+
+	if ( this->isPoleniFacesEnabled() )
+	{
+		sPoleniFaces = "Separate kernel";
+	} else if ( this->pDomain->getWeirFacesUsed() > 0 ) {
+		sPoleniFaces = "In cell kernel";
 	}
 
 	model::log->writeLine("ProMaIDes SCHEME", true, wColour);
 	model::log->writeLine("  Timestep mode:      " + (std::string)(this->bDynamicTimestep ? "Dynamic" : "Fixed"), true, wColour);
 	model::log->writeLine("  Courant number:     " + (std::string)(this->bDynamicTimestep ? toStringExact(this->dCourantNumber) : "N/A"), true, wColour);
 	model::log->writeLine("  Initial timestep:   " + Util::secondsToTime(this->dTimestep), true, wColour);
-	model::log->writeLine("  Data reduction:     " + toStringExact(this->uiTimestepReductionWavefronts) + " divisions", true, wColour);
+	model::log->writeLine("  Data reduction:     " + this->getReductionDescription(), true, wColour);
 	model::log->writeLine("  Configuration:      " + sConfiguration, true, wColour);
+	model::log->writeLine("  Fused reduction:    " + (std::string)(this->isReductionFused() ? "Enabled" : "Disabled"), true, wColour);
+	model::log->writeLine("  Fused boundaries:   " + (std::string)(this->isBoundaryFused() ? "Enabled" : "Disabled"), true, wColour);
+	model::log->writeLine("  Active tiles:       " + (std::string)(this->isActiveTilesEnabled() ? "Rebuilt every " + toStringExact(this->uiActiveTilesInterval) + " iteration(s)" : "Disabled"), true, wColour);
+	model::log->writeLine("  Wet extent launch:  " + (std::string)(this->isWetExtentEnabled() ? "Enabled" : "Disabled"), true, wColour);
+	model::log->writeLine("  Cell state layout:  " + (std::string)(this->isCellStateSoAEnabled() ? "Structure of arrays" : "Array of structures"), true, wColour);
+	model::log->writeLine("  Static data:        " + (std::string)(this->getStaticFloatSize() == sizeof(cl_float) ? "Single-precision" : "Double-precision"), true, wColour);
+	model::log->writeLine("  Stored levels:      " + (std::string)(this->isDepthEncodingEnabled() ? "Depth above bed" : "Free-surface level"), true, wColour);
+	model::log->writeLine("  Level update:       " + (std::string)(this->isDoubleFloatEnabled() ? "Double-float" : "Native"), true, wColour);
+	model::log->writeLine("  Cell ordering:      " + (std::string)(this->isCellTilingEnabled() ? "Strips of " + toStringExact(this->uiCellTileRows) + " rows" : "Row-major"), true, wColour);
+	model::log->writeLine("  Persistent loop:    " + (std::string)(this->isPersistentLoopEnabled() ? "Enabled" : "Disabled"), true, wColour);
+	model::log->writeLine("  Temporal blocking:  " + (std::string)(this->isTemporalBlockingEnabled() ? toStringExact(this->uiTemporalBlockSteps) + " steps per launch" : "Disabled"), true, wColour);
+	model::log->writeLine("  Strip mining:       " + (std::string)(this->isStripMiningEnabled() ? toStringExact(this->uiStripCells) + " cells per work-item" : "Disabled"), true, wColour);
+	model::log->writeLine("  Bed elevations:     " + (std::string)(this->isStaticImagesEnabled() ? "Image" : "Buffer"), true, wColour);
+	model::log->writeLine("  Zero timesteps:     " + (std::string)(this->isZeroTimestepSkipEnabled() ? "Skipped on device" : "Copied"), true, wColour);
+	model::log->writeLine("  Work-group size:    " + toStringExact(this->ulNonCachedWorkgroupSizeX) + "x" + toStringExact(this->ulNonCachedWorkgroupSizeY) + (std::string)(this->bAutotuneCached ? " (Tuned)" : ""), true, wColour);
+	model::log->writeLine("  Weir faces:         " + sPoleniFaces, true, wColour);
+	model::log->writeLine("  Face conductance:   " + (std::string)(this->isFaceConductanceEnabled() ? "Precomputed" : "Per timestep"), true, wColour);
+	model::log->writeLine("  Packed floodplains: " + (std::string)(this->isPackingEnabled() ? toStringExact(this->vPackGuests.size()) + " in " + toStringExact(this->ulPackCellCount) + " cells" : "None"), true, wColour);
 	model::log->writeLine("  Friction effects:   " + (std::string)(this->bFrictionEffects ? "Enabled" : "Disabled"), true, wColour);
 	model::log->writeLine("  Kernel queue mode:  " + (std::string)(this->bAutomaticQueue ? "Automatic" : "Fixed size"), true, wColour);
+	model::log->writeLine("  Command queue:      " + (std::string)(this->pDomain->getDevice()->isOutOfOrderQueue() ? "Out-of-order" : "In-order"), true, wColour);
 	model::log->writeLine((std::string)(this->bAutomaticQueue ? "  Initial queue:      " : "  Fixed queue:        ") + toStringExact(this->uiQueueAdditionSize) + " iteration(s)", true, wColour);
 	model::log->writeLine("  Debug output:       " + (std::string)(this->bDebugOutput ? "Enabled" : "Disabled"), true, wColour);
 
@@ -196,6 +291,239 @@ bool CSchemePromaides::prepareCode()
 	return bReturnState;
 }
 
+/*
+ *  Allocate constants using the settings herein
+ */
+bool CSchemePromaides::preparePromaidesConstants()
+{
+	// --
+	// Work-group size requirements
+	// --
+
+	if ( this->ucConfiguration == model::schemeConfigurations::promaidesFormula::kCacheEnabled )
+	{
+		oclModel->registerConstant(
+			"REQD_WG_SIZE_FULL_TS",
+			"__attribute__((reqd_work_group_size(" + std::to_string( this->ulCachedWorkgroupSizeX )  + ", " + std::to_string( this->ulCachedWorkgroupSizeY )  + ", 1)))"
+		);
+	}
+	if ( this->ucConfiguration == model::schemeConfigurations::promaidesFormula::kFaceCentred )
+	{
+		oclModel->registerConstant(
+			"REQD_WG_SIZE_FULL_TS",
+			"__attribute__((reqd_work_group_size(" + std::to_string( this->ulNonCachedWorkgroupSizeX )  + ", " + std::to_string( this->ulNonCachedWorkgroupSizeY )  + ", 1)))"
+		);
+	}
+
+	// --
+	// Face-centred kernels read full cell states from plain arrays
+	// --
+
+	if ( this->ucConfiguration == model::schemeConfigurations::promaidesFormula::kFaceCentred &&
+		 ( this->bReductionInFluxKernel ||
+		   this->bBoundaryInFluxKernel ||
+		   this->bActiveTiles ||
+		   this->bWetExtent ||
+		   this->bCellStateSoA ||
+		   this->bDepthEncoding ||
+		   this->bPersistentLoop ||
+		   this->bStaticImages ||
+		   this->uiStripCells > 1 ||
+		   this->uiTemporalBlockSteps > 1 ||
+		   cModel->getFloatPrecision() == model::floatPrecision::kDoubleFloat ) )
+	{
+		model::doError(
+			"Face-centred fluxes cannot be combined with fused boundaries or reductions, active tiles, wet extents, SoA or depth-encoded states, persistent loops, static images, strips, temporal blocking or double-float precision.",
+			model::errorCodes::kLevelModelStop
+		);
+		return false;
+	}
+
+	// --
+	// Size of local cache arrays (work-group plus a one cell halo)
+	// --
+
+	switch (this->ucCacheConstraints)
+	{
+	case model::cacheConstraints::promaidesFormula::kCacheActualSize:
+		oclModel->registerConstant("PRO_DIM1", std::to_string(this->ulCachedWorkgroupSizeX + 2));
+		oclModel->registerConstant("PRO_DIM2", std::to_string(this->ulCachedWorkgroupSizeY + 2));
+		break;
+	case model::cacheConstraints::promaidesFormula::kCacheAllowUndersize:
+		oclModel->registerConstant("PRO_DIM1", std::to_string(this->ulCachedWorkgroupSizeX + 2));
+		oclModel->registerConstant("PRO_DIM2", std::to_string(this->ulCachedWorkgroupSizeY + 2));
+		break;
+	case model::cacheConstraints::promaidesFormula::kCacheAllowOversize:
+		oclModel->registerConstant("PRO_DIM1", std::to_string(this->ulCachedWorkgroupSizeX + 2));
+		oclModel->registerConstant("PRO_DIM2", std::to_string(this->ulCachedWorkgroupSizeY + 2 + ( ( this->ulCachedWorkgroupSizeY + 2 ) % 2 == 0 ? 1 : 0 )));
+		break;
+	}
+
+	// --
+	// Weir faces solved ahead of the Manning-only cell update
+	// --
+
+	if ( this->isPoleniFacesEnabled() )
+	{
+		oclModel->registerConstant( "POLENI_FACES", "1" );
+	} else {
+		oclModel->removeConstant( "POLENI_FACES" );
+	}
+
+	// --
+	// Face conductances computed once from the Manning coefficients
+	// --
+
+	if ( this->isFaceConductanceEnabled() )
+	{
+		oclModel->registerConstant( "FACE_CONDUCTANCE", "1" );
+	} else {
+		oclModel->removeConstant( "FACE_CONDUCTANCE" );
+	}
+
+	// --
+	// Floodplains packed into this scheme's launches
+	// --
+
+	if ( !this->vPackGuests.empty() && !this->isPackingEnabled() )
+	{
+		model::doError(
+			"Packed floodplains need the cache disabled, fused boundaries with full arrays, no weir faces and matching devices.",
+			model::errorCodes::kLevelModelStop
+		);
+		return false;
+	}
+
+	if ( this->isPackingEnabled() )
+	{
+		oclModel->registerConstant( "PACKED_DOMAINS", std::to_string( this->vPackGuests.size() ) );
+		oclModel->registerConstant( "PACKED_GROUPSIZE", std::to_string( this->ulNonCachedWorkgroupSizeX * this->ulNonCachedWorkgroupSizeY ) );
+	} else {
+		oclModel->removeConstant( "PACKED_DOMAINS" );
+		oclModel->removeConstant( "PACKED_GROUPSIZE" );
+	}
+
+	return true;
+}
+
+/*
+ *  Allocate memory for the promaides scheme specific data
+ */
+bool CSchemePromaides::preparePromaidesMemory()
+{
+	bool						bReturnState		= true;
+	CDomain*					pDomain				= this->pDomain;
+
+	unsigned char ucStaticFloatSize = this->getStaticFloatSize();
+
+	// --
+	// Face discharges (east and north face of each cell)
+	// --
+
+	if ( this->ucConfiguration == model::schemeConfigurations::promaidesFormula::kFaceCentred )
+	{
+		oclBufferFaceFluxes = new COCLBuffer( "Face discharges", oclModel, false, true, ucStaticFloatSize * 4 * pDomain->getCellCount(), true );
+		oclBufferFaceFluxes->createBuffer();
+	}
+
+	// --
+	// Weir face discharges (one per entry in the weir face table)
+	// --
+
+	if ( this->ucConfiguration == model::schemeConfigurations::promaidesFormula::kCacheNone )
+	{
+		oclBufferWeirFaceFluxes = new COCLBuffer( "Weir face discharges", oclModel, false, true, ucStaticFloatSize * 2 * pDomain->getWeirFaceCapacity(), true );
+		oclBufferWeirFaceFluxes->createBuffer();
+	}
+
+	// --
+	// Face conductances (east and north face of each cell)
+	// --
+
+	oclBufferFaceConductances = new COCLBuffer( "Face conductances", oclModel, false, true, ucStaticFloatSize * 2 * ( this->isFaceConductanceEnabled() ? pDomain->getCellCount() : 1 ), true );
+	oclBufferFaceConductances->createBuffer();
+
+	// --
+	// Packed floodplains (each starts on a work-group boundary)
+	// --
+
+	if ( this->isPackingEnabled() )
+	{
+		unsigned char	ucFloatSize		= ( cModel->getFloatPrecision() != model::floatPrecision::kDouble ? sizeof( cl_float ) : sizeof( cl_double ) );
+		cl_ulong		ulGroupSize		= this->ulNonCachedWorkgroupSizeX * this->ulNonCachedWorkgroupSizeY;
+		unsigned int	uiGuests		= static_cast<unsigned int>( this->vPackGuests.size() );
+
+		this->ulPackCellCount = 0;
+		for( unsigned int i = 0; i < uiGuests; i++ )
+		{
+			this->vPackGuests[i]->ulPackOffset = this->ulPackCellCount;
+			this->ulPackCellCount += ulGroupSize * static_cast<cl_ulong>( ceil( this->vPackGuests[i]->pDomain->getCellCount() / static_cast<double>( ulGroupSize ) ) );
+		}
+
+		oclBufferPackStates				= new COCLBuffer( "Packed cell states", oclModel, false, false, ucFloatSize * 4 * this->ulPackCellCount );
+		oclBufferPackStatesAlt			= new COCLBuffer( "Packed cell states (alternate)", oclModel, false, false, ucFloatSize * 4 * this->ulPackCellCount );
+		oclBufferPackBed				= new COCLBuffer( "Packed bed elevations", oclModel, true, false, ucStaticFloatSize * this->ulPackCellCount );
+		oclBufferPackManning			= new COCLBuffer( "Packed Manning coefficients", oclModel, true, false, ucStaticFloatSize * this->ulPackCellCount );
+		oclBufferPackBoundary			= new COCLBuffer( "Packed boundary values", oclModel, false, false, ucFloatSize * this->ulPackCellCount );
+		oclBufferPackOffsets			= new COCLBuffer( "Packed floodplain offsets", oclModel, true, true, sizeof( cl_ulong ) * ( uiGuests + 1 ), true );
+		oclBufferPackDims				= new COCLBuffer( "Packed floodplain dimensions", oclModel, true, true, sizeof( cl_uint ) * 2 * uiGuests, true );
+		oclBufferPackResolution			= new COCLBuffer( "Packed floodplain resolution", oclModel, true, true, ucFloatSize * 2 * uiGuests, true );
+		oclBufferPackTime				= new COCLBuffer( "Packed time", oclModel, false, true, ucFloatSize * uiGuests, false );
+		oclBufferPackTimestep			= new COCLBuffer( "Packed timestep", oclModel, false, true, ucFloatSize * uiGuests, false );
+		oclBufferPackTimeHydrological	= new COCLBuffer( "Packed time (hydrological)", oclModel, false, true, ucFloatSize * uiGuests, true );
+		oclBufferPackBatchTimesteps		= new COCLBuffer( "Packed batch timesteps cumulative", oclModel, false, true, ucFloatSize * uiGuests, false );
+		oclBufferPackBatchSuccessful	= new COCLBuffer( "Packed batch successful iterations", oclModel, false, true, sizeof( cl_uint ) * uiGuests, false );
+		oclBufferPackBatchSkipped		= new COCLBuffer( "Packed batch skipped iterations", oclModel, false, true, sizeof( cl_uint ) * uiGuests, false );
+		oclBufferPackReduction			= new COCLBuffer( "Packed timestep reduction scratch", oclModel, false, true, ucFloatSize * ( this->ulPackCellCount / ulGroupSize ), true );
+
+		// Offsets, dimensions and resolution of each floodplain
+		for( unsigned int i = 0; i < uiGuests; i++ )
+		{
+			CDomainCartesian*	pGuestDomain	= static_cast<CDomainCartesian*>( this->vPackGuests[i]->pDomain );
+			double				dResolutionX, dResolutionY;
+			pGuestDomain->getCellResolution( &dResolutionX, &dResolutionY );
+
+			oclBufferPackOffsets->getHostBlock<cl_ulong*>()[ i ]		= this->vPackGuests[i]->ulPackOffset;
+			oclBufferPackDims->getHostBlock<cl_uint*>()[ i * 2 ]		= static_cast<cl_uint>( pGuestDomain->getCols() );
+			oclBufferPackDims->getHostBlock<cl_uint*>()[ i * 2 + 1 ]	= static_cast<cl_uint>( pGuestDomain->getRows() );
+
+			if ( cModel->getFloatPrecision() != model::floatPrecision::kDouble )
+			{
+				oclBufferPackResolution->getHostBlock<cl_float*>()[ i * 2 ]		= static_cast<cl_float>( dResolutionX );
+				oclBufferPackResolution->getHostBlock<cl_float*>()[ i * 2 + 1 ]	= static_cast<cl_float>( dResolutionY );
+			} else {
+				oclBufferPackResolution->getHostBlock<cl_double*>()[ i * 2 ]		= dResolutionX;
+				oclBufferPackResolution->getHostBlock<cl_double*>()[ i * 2 + 1 ]	= dResolutionY;
+			}
+		}
+		oclBufferPackOffsets->getHostBlock<cl_ulong*>()[ uiGuests ]	= this->ulPackCellCount;
+
+		oclBufferPackStates->createBuffer();
+		oclBufferPackStatesAlt->createBuffer();
+		oclBufferPackBed->createBuffer();
+		oclBufferPackManning->createBuffer();
+		oclBufferPackBoundary->createBuffer();
+		oclBufferPackOffsets->createBuffer();
+		oclBufferPackDims->createBuffer();
+		oclBufferPackResolution->createBuffer();
+		oclBufferPackTimeHydrological->createBuffer();
+
+		// What the host reads back each batch sits in the batch status block
+		cl_ulong	ulFloatStatus	= this->getPackStatusSize( ucFloatSize );
+		cl_ulong	ulUintStatus	= this->getPackStatusSize( sizeof( cl_uint ) );
+		cl_ulong	ulStatusOffset	= this->ulBatchStatusExtraOffset;
+
+		oclBufferPackTime->createSubBuffer( oclBufferBatchStatus, ulStatusOffset );
+		oclBufferPackTimestep->createSubBuffer( oclBufferBatchStatus, ulStatusOffset + ulFloatStatus );
+		oclBufferPackBatchTimesteps->createSubBuffer( oclBufferBatchStatus, ulStatusOffset + 2 * ulFloatStatus );
+		oclBufferPackBatchSuccessful->createSubBuffer( oclBufferBatchStatus, ulStatusOffset + 3 * ulFloatStatus );
+		oclBufferPackBatchSkipped->createSubBuffer( oclBufferBatchStatus, ulStatusOffset + 3 * ulFloatStatus + ulUintStatus );
+		oclBufferPackReduction->createBuffer();
+	}
+
+	return bReturnState;
+}
+
 /*
  *  Create kernels using the compiled program
  */
@@ -211,12 +539,115 @@ bool CSchemePromaides::preparePromaidesKernels()
 	// --
 
 
-	oclKernelFullTimestep = oclModel->getKernel( "pro_cacheDisabled" );
-	oclKernelFullTimestep->setGroupSize( this->ulNonCachedWorkgroupSizeX, this->ulNonCachedWorkgroupSizeY );
-	oclKernelFullTimestep->setGlobalSize( this->ulNonCachedGlobalSizeX, this->ulNonCachedGlobalSizeY );
-	COCLBuffer* aryArgsFullTimestep[] = { oclBufferTimestep, oclBufferCellBed, oclBufferCellStates, oclBufferCellStatesAlt, oclBufferCellManning, oclBufferUsePoleni, oclBuffer_opt_zxmax, oclBuffer_opt_cx, oclBuffer_opt_zymax, oclBuffer_opt_cy };
-	oclKernelFullTimestep->assignArguments( aryArgsFullTimestep );
+	if ( this->isFaceConductanceEnabled() )
+	{
+		oclKernelFaceConductances = oclModel->getKernel( "pro_faceConductances" );
+		oclKernelFaceConductances->setGroupSize( this->ulNonCachedWorkgroupSizeX, this->ulNonCachedWorkgroupSizeY );
+		oclKernelFaceConductances->setGlobalSize( this->ulNonCachedGlobalSizeX, this->ulNonCachedGlobalSizeY );
+		COCLBuffer* aryArgsFaceConductances[] = { oclBufferCellManning, oclBufferFaceConductances };
+		oclKernelFaceConductances->assignArguments( aryArgsFaceConductances );
+	}
+
+	if ( this->ucConfiguration == model::schemeConfigurations::promaidesFormula::kFaceCentred )
+	{
+		oclKernelFaceFluxes = oclModel->getKernel( "pro_faceFluxes" );
+		oclKernelFaceFluxes->setGroupSize( this->ulNonCachedWorkgroupSizeX, this->ulNonCachedWorkgroupSizeY );
+		oclKernelFaceFluxes->setGlobalSize( this->ulNonCachedGlobalSizeX, this->ulNonCachedGlobalSizeY );
+		COCLBuffer* aryArgsFaceFluxes[] = { oclBufferTimestep, oclBufferCellBed, oclBufferCellStates, oclBufferFaceFluxes, oclBufferCellManning, oclBufferPoleniMasks, oclBufferWeirFaceIDs, oclBufferWeirFaceValues, oclBufferFaceConductances };
+		oclKernelFaceFluxes->assignArguments( aryArgsFaceFluxes );
+
+		oclKernelFullTimestep = oclModel->getKernel( "pro_faceAccumulate" );
+		oclKernelFullTimestep->setGroupSize( this->ulNonCachedWorkgroupSizeX, this->ulNonCachedWorkgroupSizeY );
+		oclKernelFullTimestep->setGlobalSize( this->ulNonCachedGlobalSizeX, this->ulNonCachedGlobalSizeY );
+		COCLBuffer* aryArgsFullTimestep[] = { oclBufferTimestep, oclBufferCellBed, oclBufferCellStates, oclBufferCellStatesAlt, oclBufferFaceFluxes };
+		oclKernelFullTimestep->assignArguments( aryArgsFullTimestep );
+	} else if ( this->ucConfiguration == model::schemeConfigurations::promaidesFormula::kCacheEnabled ) {
+		oclKernelFullTimestep = oclModel->getKernel( "pro_cacheEnabled" );
+		oclKernelFullTimestep->setGroupSize( this->ulCachedWorkgroupSizeX, this->ulCachedWorkgroupSizeY );
+		oclKernelFullTimestep->setGlobalSize( this->ulNonCachedGlobalSizeX, this->ulNonCachedGlobalSizeY );
+		COCLBuffer* aryArgsFullTimestep[] = { oclBufferTimestep, oclBufferCellBed, oclBufferCellStates, oclBufferCellStatesAlt, oclBufferCellManning, oclBufferPoleniMasks, oclBufferWeirFaceIDs, oclBufferWeirFaceValues };
+		oclKernelFullTimestep->assignArguments( aryArgsFullTimestep );
+	} else if ( this->isTemporalBlockingEnabled() ) {
+		oclKernelFullTimestep = oclModel->getKernel( "pro_temporalBlock" );
+		oclKernelFullTimestep->setGroupSize( this->ulNonCachedWorkgroupSizeX, this->ulNonCachedWorkgroupSizeY );
+		oclKernelFullTimestep->setGlobalSize( this->ulTemporalBlockGlobalSizeX, this->ulTemporalBlockGlobalSizeY );
+		COCLBuffer* aryArgsFullTimestep[] = { oclBufferTimestep, oclBufferCellBed, oclBufferCellStates, oclBufferCellStatesAlt, oclBufferCellManning, oclBufferPoleniMasks, oclBufferWeirFaceIDs, oclBufferWeirFaceValues, this->getBoundaryRateBuffer() };
+		oclKernelFullTimestep->assignArguments( aryArgsFullTimestep );
+	} else {
+		oclKernelFullTimestep = oclModel->getKernel( this->isStripMiningEnabled() ? "pro_cacheDisabledStrip" : "pro_cacheDisabled" );
+		oclKernelFullTimestep->setGroupSize( this->ulNonCachedWorkgroupSizeX, this->ulNonCachedWorkgroupSizeY );
+		oclKernelFullTimestep->setGlobalSize( this->ulNonCachedGlobalSizeX, this->isStripMiningEnabled() ? this->ulStripGlobalSizeY : this->ulNonCachedGlobalSizeY );
+		COCLBuffer* aryArgsFullTimestep[] = { oclBufferTimestep, this->getStaticBedBuffer(), oclBufferCellStates, oclBufferCellStatesAlt, oclBufferCellManning, oclBufferPoleniMasks, oclBufferWeirFaceIDs, oclBufferWeirFaceFluxes, oclBufferTimestepReduction, this->getBoundaryRateBuffer(), oclBufferActiveTiles, oclBufferCellFSLLow, oclBufferFaceConductances };
+		oclKernelFullTimestep->assignArguments( aryArgsFullTimestep );
+
+		if ( this->isPoleniFacesEnabled() )
+		{
+			// Only the faces in use, the rest of the table is padding
+			unsigned long ulWeirFaceCount = pDomain->getWeirFacesUsed();
+
+			oclKernelPoleniFaces = oclModel->getKernel( "pro_poleniFaces" );
+			oclKernelPoleniFaces->setGroupSize( 64 );
+			oclKernelPoleniFaces->setGlobalSize( 64*ceil( ulWeirFaceCount/64.0 ) );
+			COCLBuffer* aryArgsPoleniFaces[] = { oclBufferTimestep, oclBufferCellBed, oclBufferCellStates, oclBufferPoleniMasks, oclBufferWeirFaceIDs, oclBufferWeirFaceValues, oclBufferWeirFaceFluxes };
+			oclKernelPoleniFaces->assignArguments( aryArgsPoleniFaces );
+		}
+
+		if ( this->isPersistentLoopEnabled() )
+		{
+			oclKernelPersistentLoop = oclModel->getKernel( "pro_persistentLoop" );
+			oclKernelPersistentLoop->setGroupSize( this->ulNonCachedWorkgroupSizeX * this->ulNonCachedWorkgroupSizeY );
+			oclKernelPersistentLoop->setGlobalSize( this->ulNonCachedWorkgroupSizeX * this->ulNonCachedWorkgroupSizeY );
+			COCLBuffer* aryArgsPersistentLoop[] = { oclBufferTime, oclBufferTimestep, oclBufferCellStates, oclBufferCellStatesAlt, oclBufferTimeHydrological, oclBufferTimeTarget, oclBufferBatchTimesteps, oclBufferBatchSuccessful, oclBufferBatchSkipped, oclBufferIterationBudget, oclBufferCellBed, oclBufferCellManning, oclBufferPoleniMasks, oclBufferWeirFaceIDs, oclBufferWeirFaceValues, oclBufferWeirFaceFluxes, this->getBoundaryRateBuffer(), oclBufferCellFSLLow, oclBufferFaceConductances };
+			oclKernelPersistentLoop->assignArguments( aryArgsPersistentLoop );
+		}
+
+		if ( this->isPackingEnabled() )
+		{
+			oclKernelPackedCells = oclModel->getKernel( "pro_packedCacheDisabled" );
+			oclKernelPackedCells->setGroupSize( this->ulNonCachedWorkgroupSizeX * this->ulNonCachedWorkgroupSizeY );
+			oclKernelPackedCells->setGlobalSize( this->ulPackCellCount );
+			COCLBuffer* aryArgsPackedCells[] = { oclBufferPackTimestep, oclBufferPackBed, oclBufferPackStates, oclBufferPackStatesAlt, oclBufferPackManning, oclBufferPackBoundary, oclBufferPackOffsets, oclBufferPackDims, oclBufferPackResolution, oclBufferPackReduction };
+			oclKernelPackedCells->assignArguments( aryArgsPackedCells );
+
+			oclKernelPackedAdvance = oclModel->getKernel( "pro_packedAdvance" );
+			oclKernelPackedAdvance->setGroupSize( 1 );
+			oclKernelPackedAdvance->setGlobalSize( this->vPackGuests.size() );
+			COCLBuffer* aryArgsPackedAdvance[] = { oclBufferPackTime, oclBufferPackTimestep, oclBufferPackTimeHydrological, oclBufferTimeTarget, oclBufferPackBatchTimesteps, oclBufferPackBatchSuccessful, oclBufferPackBatchSkipped, oclBufferPackReduction, oclBufferPackOffsets };
+			oclKernelPackedAdvance->assignArguments( aryArgsPackedAdvance );
+		}
+	}
+
+
+	return bReturnState;
+}
+
+/*
+ *  Swap the source and destination in second instances of the face and packed
+ *  kernels too, alongside the base kernels
+ */
+bool CSchemePromaides::prepareAlternateKernels()
+{
+	bool bReturnState = CSchemeGodunov::prepareAlternateKernels();
+
+	if ( oclKernelFaceFluxes != NULL )
+	{
+		bReturnState &= oclKernelFaceFluxes->assignArgument( 2, oclBufferCellStates );					// Src
+		bReturnState &= oclKernelFaceFluxes->assignAlternateArgument( 2, oclBufferCellStatesAlt );		// Src
+	}
+
+	if ( oclKernelPoleniFaces != NULL )
+	{
+		bReturnState &= oclKernelPoleniFaces->assignArgument( 2, oclBufferCellStates );				// Src
+		bReturnState &= oclKernelPoleniFaces->assignAlternateArgument( 2, oclBufferCellStatesAlt );	// Src
+	}
 
+	if ( oclKernelPackedCells != NULL )
+	{
+		bReturnState &= oclKernelPackedCells->assignArgument( 2, oclBufferPackStates );				// Src
+		bReturnState &= oclKernelPackedCells->assignArgument( 3, oclBufferPackStatesAlt );				// Dst
+		bReturnState &= oclKernelPackedCells->assignAlternateArgument( 2, oclBufferPackStatesAlt );	// Src
+		bReturnState &= oclKernelPackedCells->assignAlternateArgument( 3, oclBufferPackStates );		// Dst
+	}
 
 	return bReturnState;
 }
@@ -243,7 +674,301 @@ void CSchemePromaides::releasePromaidesResources()
 
 	model::log->writeLine("Releasing Promaides scheme resources held for OpenCL.");
 
-	// Nothing to do?
+	if ( this->oclKernelFaceFluxes != NULL )				delete oclKernelFaceFluxes;
+	if ( this->oclKernelPoleniFaces != NULL )				delete oclKernelPoleniFaces;
+	if ( this->oclBufferFaceFluxes != NULL )				delete oclBufferFaceFluxes;
+	if ( this->oclBufferWeirFaceFluxes != NULL )			delete oclBufferWeirFaceFluxes;
+	if ( this->oclKernelFaceConductances != NULL )			delete oclKernelFaceConductances;
+	if ( this->oclBufferFaceConductances != NULL )			delete oclBufferFaceConductances;
+	if ( this->oclKernelPackedCells != NULL )				delete oclKernelPackedCells;
+	if ( this->oclKernelPackedAdvance != NULL )				delete oclKernelPackedAdvance;
+	if ( this->oclBufferPackStates != NULL )				delete oclBufferPackStates;
+	if ( this->oclBufferPackStatesAlt != NULL )				delete oclBufferPackStatesAlt;
+	if ( this->oclBufferPackBed != NULL )					delete oclBufferPackBed;
+	if ( this->oclBufferPackManning != NULL )				delete oclBufferPackManning;
+	if ( this->oclBufferPackBoundary != NULL )				delete oclBufferPackBoundary;
+	if ( this->oclBufferPackOffsets != NULL )				delete oclBufferPackOffsets;
+	if ( this->oclBufferPackDims != NULL )					delete oclBufferPackDims;
+	if ( this->oclBufferPackResolution != NULL )			delete oclBufferPackResolution;
+	if ( this->oclBufferPackTime != NULL )					delete oclBufferPackTime;
+	if ( this->oclBufferPackTimestep != NULL )				delete oclBufferPackTimestep;
+	if ( this->oclBufferPackTimeHydrological != NULL )		delete oclBufferPackTimeHydrological;
+	if ( this->oclBufferPackBatchTimesteps != NULL )		delete oclBufferPackBatchTimesteps;
+	if ( this->oclBufferPackBatchSuccessful != NULL )		delete oclBufferPackBatchSuccessful;
+	if ( this->oclBufferPackBatchSkipped != NULL )			delete oclBufferPackBatchSkipped;
+	if ( this->oclBufferPackReduction != NULL )				delete oclBufferPackReduction;
+
+	oclKernelFaceFluxes				= NULL;
+	oclKernelPoleniFaces			= NULL;
+	oclBufferFaceFluxes				= NULL;
+	oclBufferWeirFaceFluxes			= NULL;
+	oclKernelFaceConductances		= NULL;
+	oclBufferFaceConductances		= NULL;
+	oclKernelPackedCells			= NULL;
+	oclKernelPackedAdvance			= NULL;
+	oclBufferPackStates				= NULL;
+	oclBufferPackStatesAlt			= NULL;
+	oclBufferPackBed				= NULL;
+	oclBufferPackManning			= NULL;
+	oclBufferPackBoundary			= NULL;
+	oclBufferPackOffsets			= NULL;
+	oclBufferPackDims				= NULL;
+	oclBufferPackResolution			= NULL;
+	oclBufferPackTime				= NULL;
+	oclBufferPackTimestep			= NULL;
+	oclBufferPackTimeHydrological	= NULL;
+	oclBufferPackBatchTimesteps		= NULL;
+	oclBufferPackBatchSuccessful	= NULL;
+	oclBufferPackBatchSkipped		= NULL;
+	oclBufferPackReduction			= NULL;
+}
+
+/*
+ *  Are the weir faces solved by their own kernel ahead of the Manning-only
+ *  cell update? Only when weir faces are actually set in the domain, and not
+ *  when the temporally blocked kernel solves them inline.
+ */
+bool	CSchemePromaides::isPoleniFacesEnabled()
+{
+	return this->ucConfiguration == model::schemeConfigurations::promaidesFormula::kCacheNone &&
+		   this->pDomain->getWeirFacesUsed() > 0 &&
+		   !this->isTemporalBlockingEnabled();
+}
+
+/*
+ *  Are the face conductances computed once before the run? Only for the
+ *  kernels that take them, i.e. the uncached cell update and the face-centred
+ *  fluxes.
+ */
+bool	CSchemePromaides::isFaceConductanceEnabled()
+{
+	return ( this->ucConfiguration == model::schemeConfigurations::promaidesFormula::kCacheNone &&
+			 !this->isTemporalBlockingEnabled() ) ||
+		   this->ucConfiguration == model::schemeConfigurations::promaidesFormula::kFaceCentred;
+}
+
+/*
+ *  Does each batch run from a single launch of one work-group?
+ */
+bool	CSchemePromaides::isPersistentLoopEnabled()
+{
+	return this->ucConfiguration == model::schemeConfigurations::promaidesFormula::kCacheNone &&
+		   this->isPersistentLoopPossible();
+}
+
+/*
+ *  Does the flux kernel advance several timesteps?
+ */
+bool	CSchemePromaides::isTemporalBlockingEnabled()
+{
+	return this->ucConfiguration == model::schemeConfigurations::promaidesFormula::kCacheNone &&
+		   this->isTemporalBlockingPossible();
+}
+
+/*
+ *  Does each flux work-item walk up a strip of cells?
+ */
+bool	CSchemePromaides::isStripMiningEnabled()
+{
+	return this->ucConfiguration == model::schemeConfigurations::promaidesFormula::kCacheNone &&
+		   this->isStripMiningPossible();
+}
+
+/*
+ *  Are the bed and Manning values read as images? Not when floodplains are
+ *  packed, as their cells share the flux kernel's loader with this domain
+ *  and are only held in buffers.
+ */
+bool	CSchemePromaides::isStaticImagesEnabled()
+{
+	return CSchemeGodunov::isStaticImagesEnabled() &&
+		   !this->isPackingEnabled();
+}
+
+/*
+ *  Does the flux kernel read the Manning values as an image? The uncached
+ *  kernels only read the precomputed face conductances.
+ */
+bool	CSchemePromaides::isManningImageEnabled()
+{
+	return false;
+}
+
+/*
+ *  Are zero-timestep iterations skipped without a copy? Packed floodplains
+ *  share the leader's buffer parity but skip on their own timesteps, and
+ *  are never updated by their own kernels.
+ */
+bool	CSchemePromaides::isZeroTimestepSkipEnabled()
+{
+	return CSchemeGodunov::isZeroTimestepSkipEnabled() &&
+		   this->pPackLeader == NULL &&
+		   !this->isPackingEnabled();
+}
+
+/*
+ *  Are packed floodplains updated alongside this one? Only by a leader with
+ *  the cache disabled and the boundary rates applied by the cell update from
+ *  full arrays, without the kernels that assume a single domain, and only
+ *  for floodplains without weir faces on the same device.
+ */
+bool	CSchemePromaides::isPackingEnabled()
+{
+	if ( this->pPackLeader != NULL || this->vPackGuests.empty() )
+		return false;
+
+	if ( this->ucConfiguration != model::schemeConfigurations::promaidesFormula::kCacheNone ||
+		 this->bUseOptimizedBoundary ||
+		 !this->isBoundaryFused() ||
+		 this->isCellStateSoAEnabled() ||
+		 this->isDoubleFloatEnabled() ||
+		 this->isTemporalBlockingEnabled() ||
+		 this->isPersistentLoopEnabled() )
+		return false;
+
+	for( unsigned int i = 0; i < this->vPackGuests.size(); i++ )
+	{
+		CSchemePromaides* pGuest = this->vPackGuests[i];
+
+		if ( pGuest->bUseOptimizedBoundary ||
+			 pGuest->pDomain->getWeirFacesUsed() > 0 ||
+			 pGuest->pDomain->getDevice() != this->pDomain->getDevice() ||
+			 pGuest->cModel->getFloatPrecision() != this->cModel->getFloatPrecision() )
+			return false;
+	}
+
+	return true;
+}
+
+/*
+ *  Bytes taken by one of the packed floodplains' status arrays in the batch
+ *  status block, rounded up so the next starts on the sub-buffer alignment
+ */
+cl_ulong	CSchemePromaides::getPackStatusSize( unsigned char ucEntrySize )
+{
+	cl_ulong ulBytes = static_cast<cl_ulong>( ucEntrySize ) * this->vPackGuests.size();
+
+	return this->ulBatchStatusStride * static_cast<cl_ulong>( ceil( ulBytes / static_cast<double>( this->ulBatchStatusStride ) ) );
+}
+
+/*
+ *  Bytes of the packed floodplains' time, timestep and batch counters, which
+ *  are read back in the same transfer as this scheme's
+ */
+cl_ulong	CSchemePromaides::getBatchStatusExtraSize()
+{
+	if ( !this->isPackingEnabled() )
+		return 0;
+
+	unsigned char ucFloatSize = ( cModel->getFloatPrecision() != model::floatPrecision::kDouble ? sizeof( cl_float ) : sizeof( cl_double ) );
+
+	return 3 * this->getPackStatusSize( ucFloatSize ) +
+		   2 * this->getPackStatusSize( sizeof( cl_uint ) );
+}
+
+/*
+ *  Runs the actual simulation until completion or error
+ */
+void	CSchemePromaides::scheduleIteration(
+					bool						bUseAlternateKernel,
+					COCLDevice*					pDevice,
+					CDomain*					pDomain
+		)
+{
+	// The packed floodplains share nothing this domain's update writes, so an
+	// out-of-order queue can run their cells alongside it
+	if ( this->isPackingEnabled() )
+		this->schedulePackedCells( bUseAlternateKernel, pDevice );
+
+	// Face discharges are solved from the source states before the cell update
+	if ( this->ucConfiguration == model::schemeConfigurations::promaidesFormula::kFaceCentred )
+	{
+		oclKernelFaceFluxes->setAlternate( bUseAlternateKernel );
+
+		this->cModel->profiler->profile("oclKernelFaceFluxes", CProfiler::profilerFlags::START_PROFILING);
+		oclKernelFaceFluxes->scheduleExecution();
+		pDevice->queueBarrier();
+		this->cModel->profiler->profile("oclKernelFaceFluxes", CProfiler::profilerFlags::END_PROFILING, this->pDomain->getDevice());
+	}
+
+	// Weir face discharges are solved from the source states before the cell update
+	if ( this->oclKernelPoleniFaces != NULL )
+	{
+		oclKernelPoleniFaces->setAlternate( bUseAlternateKernel );
+
+		this->cModel->profiler->profile("oclKernelPoleniFaces", CProfiler::profilerFlags::START_PROFILING);
+		oclKernelPoleniFaces->scheduleExecution();
+		pDevice->queueBarrier();
+		this->cModel->profiler->profile("oclKernelPoleniFaces", CProfiler::profilerFlags::END_PROFILING, this->pDomain->getDevice());
+	}
+
+	CSchemeGodunov::scheduleIteration( bUseAlternateKernel, pDevice, pDomain );
+
+	if ( this->isPackingEnabled() )
+		this->schedulePackedAdvance( pDevice );
+}
+
+/*
+ *  Update the cells of every packed floodplain by one of its own timesteps,
+ *  alternating the packed cell states in step with this scheme's own. The
+ *  barrier following this domain's first kernel orders it before the advance.
+ */
+void	CSchemePromaides::schedulePackedCells(
+					bool						bUseAlternateKernel,
+					COCLDevice*					pDevice
+		)
+{
+	oclKernelPackedCells->setAlternate( bUseAlternateKernel );
+
+	this->cModel->profiler->profile("oclKernelPackedCells", CProfiler::profilerFlags::START_PROFILING);
+	oclKernelPackedCells->scheduleExecution();
+	this->cModel->profiler->profile("oclKernelPackedCells", CProfiler::profilerFlags::END_PROFILING, this->pDomain->getDevice());
+}
+
+/*
+ *  Advance the time of every packed floodplain from its reduced speeds
+ */
+void	CSchemePromaides::schedulePackedAdvance(
+					COCLDevice*					pDevice
+		)
+{
+	this->cModel->profiler->profile("oclKernelPackedAdvance", CProfiler::profilerFlags::START_PROFILING);
+	oclKernelPackedAdvance->scheduleExecution();
+	pDevice->queueBarrier();
+	this->cModel->profiler->profile("oclKernelPackedAdvance", CProfiler::profilerFlags::END_PROFILING, this->pDomain->getDevice());
+}
+
+/*
+ *  Write the imported boundary values to the device, including those of the
+ *  packed floodplains, whose batch counters restart with the new values
+ */
+void	CSchemePromaides::scheduleBoundaryWrite( COCLDevice* pDevice )
+{
+	CSchemeGodunov::scheduleBoundaryWrite( pDevice );
+
+	if ( !this->isPackingEnabled() )
+		return;
+
+	unsigned char ucFloatSize = ( cModel->getFloatPrecision() != model::floatPrecision::kDouble ? sizeof( cl_float ) : sizeof( cl_double ) );
+
+	for( unsigned int i = 0; i < this->vPackGuests.size(); i++ )
+	{
+		CSchemePromaides* pGuest = this->vPackGuests[i];
+		oclBufferPackBoundary->queueWritePartial( pGuest->ulPackOffset * ucFloatSize, pGuest->pDomain->getCellCount() * ucFloatSize, pGuest->pPackBoundaryValues );
+
+		if ( ucFloatSize == sizeof( cl_float ) )
+		{
+			oclBufferPackBatchTimesteps->getHostBlock<cl_float*>()[ i ]	= 0.0f;
+		} else {
+			oclBufferPackBatchTimesteps->getHostBlock<cl_double*>()[ i ]	= 0.0;
+		}
+		oclBufferPackBatchSuccessful->getHostBlock<cl_uint*>()[ i ]		= 0;
+		oclBufferPackBatchSkipped->getHostBlock<cl_uint*>()[ i ]		= 0;
+	}
+
+	oclBufferPackBatchTimesteps->queueWriteAll();
+	oclBufferPackBatchSuccessful->queueWriteAll();
+	oclBufferPackBatchSkipped->queueWriteAll();
 }
 
 /*
@@ -277,3 +1002,308 @@ unsigned char	CSchemePromaides::getCacheConstraints()
 {
 	return this->ucCacheConstraints;
 }
+
+/*
+ *  Scheme name used in the tuning cache key
+ */
+std::string	CSchemePromaides::getAutotuneScheme()
+{
+	return "Promaides";
+}
+
+/*
+ *  Tuning cache key, adding the settings only the Promaides kernels compile in
+ */
+std::string	CSchemePromaides::getAutotuneKey()
+{
+	return CSchemeGodunov::getAutotuneKey() +
+		   (std::string)( this->isPoleniFacesEnabled() ? "|PF" : "" ) +
+		   (std::string)( this->isFaceConductanceEnabled() ? "|C" : "" ) +
+		   (std::string)( this->isPersistentLoopEnabled() ? "|P" : "" ) +
+		   (std::string)( this->isPackingEnabled() ? "|K" + toStringExact( this->vPackGuests.size() ) : "" );
+}
+
+/*
+ *  Pack this floodplain into the launches of another scheme on the same
+ *  device. Must be set before either scheme is prepared, with this one
+ *  prepared first.
+ */
+void	CSchemePromaides::setPackLeader( CSchemePromaides* pLeader )
+{
+	this->pPackLeader = pLeader;
+}
+
+/*
+ *  Get the scheme this floodplain is packed into
+ */
+CSchemePromaides*	CSchemePromaides::getPackLeader()
+{
+	return this->pPackLeader;
+}
+
+/*
+ *  Prepare a floodplain packed into another scheme, which only needs the
+ *  host copies of its domain data for the leader to upload
+ */
+void	CSchemePromaides::preparePackedGuest()
+{
+	this->releaseResources();
+
+	this->ulCurrentCellsCalculated = 0;
+	this->dCurrentTimestep = this->dTimestep;
+	this->dCurrentTime = 0;
+
+	unsigned char ucFloatSize = ( cModel->getFloatPrecision() != model::floatPrecision::kDouble ? sizeof( cl_float ) : sizeof( cl_double ) );
+
+	void* pPoleniMasks		= NULL;
+	void* pWeirFaceIDs		= NULL;
+	void* pWeirFaceValues	= NULL;
+	void* pCouplingIDs		= NULL;
+	void* pCouplingValues	= NULL;
+
+	this->pDomain->createStoreBuffers(
+		&this->pPackCellStates,
+		&this->pPackBedElevations,
+		&this->pPackManningValues,
+		&this->pPackBoundaryValues,
+		&pPoleniMasks,
+		&pWeirFaceIDs,
+		&pWeirFaceValues,
+		&pCouplingIDs,
+		&pCouplingValues,
+		ucFloatSize,
+		this->pPackLeader->getStaticFloatSize(),
+		false,
+		this->pPackLeader->isDepthEncodingEnabled()
+	);
+
+	if ( std::find( this->pPackLeader->vPackGuests.begin(), this->pPackLeader->vPackGuests.end(), this ) == this->pPackLeader->vPackGuests.end() )
+		this->pPackLeader->vPackGuests.push_back( this );
+
+	model::log->writeLine( "Floodplain packed into the launches of another scheme." );
+
+	this->bCellStatesSynced = true;
+	this->bReady = true;
+}
+
+/*
+ *  Read back the latest states of a packed floodplain into its host copy
+ */
+void	CSchemePromaides::readPackedGuest( CSchemePromaides* pGuest )
+{
+	unsigned char	ucFloatSize		= ( cModel->getFloatPrecision() != model::floatPrecision::kDouble ? sizeof( cl_float ) : sizeof( cl_double ) );
+	COCLBuffer*		pBufferLatest	= bUseAlternateKernel ? oclBufferPackStatesAlt : oclBufferPackStates;
+
+	this->cModel->profiler->profile("readDomainAll", CProfiler::profilerFlags::START_PROFILING);
+	pBufferLatest->queueReadPartial( pGuest->ulPackOffset * 4 * ucFloatSize, pGuest->pDomain->getCellCount() * 4 * ucFloatSize, pGuest->pPackCellStates );
+	this->cModel->profiler->profile("readDomainAll", CProfiler::profilerFlags::END_PROFILING, this->pDomain->getDevice());
+}
+
+/*
+ *  Read back all of the domain data
+ */
+void	CSchemePromaides::readDomainAll()
+{
+	if ( this->pPackLeader != NULL )
+	{
+		this->pPackLeader->readPackedGuest( this );
+		return;
+	}
+
+	CSchemeGodunov::readDomainAll();
+}
+
+/*
+ *  Read back the free-surface levels only
+ */
+void	CSchemePromaides::readDomainFSL()
+{
+	if ( this->pPackLeader != NULL )
+	{
+		this->pPackLeader->readPackedGuest( this );
+		return;
+	}
+
+	CSchemeGodunov::readDomainFSL();
+}
+
+/*
+ *  Load in the link zone data, which for a packed floodplain is written by
+ *  the leader along with its own
+ */
+void	CSchemePromaides::importLinkZoneData()
+{
+	if ( this->pPackLeader != NULL )
+	{
+		this->pPackLeader->importLinkZoneData();
+		return;
+	}
+
+	CSchemeGodunov::importLinkZoneData();
+}
+
+/*
+ *  Set everything up to start running, uploading the packed floodplains
+ *  into their slices of the packed buffers
+ */
+void	CSchemePromaides::prepareSimulation()
+{
+	// The leader uploads packed floodplains
+	if ( this->pPackLeader != NULL )
+		return;
+
+	CSchemeGodunov::prepareSimulation();
+
+	// Manning coefficients are on the device now and don't change
+	if ( this->oclKernelFaceConductances != NULL )
+	{
+		this->oclKernelFaceConductances->scheduleExecution();
+		this->pDomain->getDevice()->blockUntilFinished();
+	}
+
+	if ( !this->isPackingEnabled() )
+		return;
+
+	model::log->writeLine( "Copying packed floodplain data to device..." );
+
+	unsigned char ucFloatSize		= ( cModel->getFloatPrecision() != model::floatPrecision::kDouble ? sizeof( cl_float ) : sizeof( cl_double ) );
+	unsigned char ucStaticFloatSize	= this->getStaticFloatSize();
+
+	for( unsigned int i = 0; i < this->vPackGuests.size(); i++ )
+	{
+		CSchemePromaides*	pGuest		= this->vPackGuests[i];
+		cl_ulong			ulOffset	= pGuest->ulPackOffset;
+		cl_ulong			ulCells		= pGuest->pDomain->getCellCount();
+
+		oclBufferPackStates->queueWritePartial( ulOffset * 4 * ucFloatSize, ulCells * 4 * ucFloatSize, pGuest->pPackCellStates );
+		oclBufferPackStatesAlt->queueWritePartial( ulOffset * 4 * ucFloatSize, ulCells * 4 * ucFloatSize, pGuest->pPackCellStates );
+		oclBufferPackBed->queueWritePartial( ulOffset * ucStaticFloatSize, ulCells * ucStaticFloatSize, pGuest->pPackBedElevations );
+		oclBufferPackManning->queueWritePartial( ulOffset * ucStaticFloatSize, ulCells * ucStaticFloatSize, pGuest->pPackManningValues );
+		oclBufferPackBoundary->queueWritePartial( ulOffset * ucFloatSize, ulCells * ucFloatSize, pGuest->pPackBoundaryValues );
+
+		// Every floodplain starts from this scheme's initial timestep
+		if ( ucFloatSize == sizeof( cl_float ) )
+		{
+			oclBufferPackTime->getHostBlock<cl_float*>()[ i ]				= 0.0f;
+			oclBufferPackTimestep->getHostBlock<cl_float*>()[ i ]			= static_cast<cl_float>( this->dCurrentTimestep );
+			oclBufferPackTimeHydrological->getHostBlock<cl_float*>()[ i ]	= 0.0f;
+			oclBufferPackBatchTimesteps->getHostBlock<cl_float*>()[ i ]		= 0.0f;
+		} else {
+			oclBufferPackTime->getHostBlock<cl_double*>()[ i ]				= 0.0;
+			oclBufferPackTimestep->getHostBlock<cl_double*>()[ i ]			= this->dCurrentTimestep;
+			oclBufferPackTimeHydrological->getHostBlock<cl_double*>()[ i ]	= 0.0;
+			oclBufferPackBatchTimesteps->getHostBlock<cl_double*>()[ i ]	= 0.0;
+		}
+		oclBufferPackBatchSuccessful->getHostBlock<cl_uint*>()[ i ]		= 0;
+		oclBufferPackBatchSkipped->getHostBlock<cl_uint*>()[ i ]		= 0;
+
+		pGuest->dCurrentTime		= 0.0;
+		pGuest->dCurrentTimestep	= this->dCurrentTimestep;
+		pGuest->dBatchTimesteps		= 0.0;
+		pGuest->uiBatchSuccessful	= 0;
+		pGuest->uiBatchSkipped		= 0;
+		pGuest->bCellStatesSynced	= true;
+	}
+
+	oclBufferPackOffsets->queueWriteAll();
+	oclBufferPackDims->queueWriteAll();
+	oclBufferPackResolution->queueWriteAll();
+	oclBufferPackTime->queueWriteAll();
+	oclBufferPackTimestep->queueWriteAll();
+	oclBufferPackTimeHydrological->queueWriteAll();
+	oclBufferPackBatchTimesteps->queueWriteAll();
+	oclBufferPackBatchSuccessful->queueWriteAll();
+	oclBufferPackBatchSkipped->queueWriteAll();
+	this->pDomain->getDevice()->blockUntilFinished();
+}
+
+/*
+ *  Fetch the key details back to the right places in memory, handing each
+ *  packed floodplain its own. This scheme only reports reaching a time once
+ *  every packed floodplain has reached it too.
+ */
+void	CSchemePromaides::readKeyStatistics()
+{
+	// The leader hands packed floodplains their statistics
+	if ( this->pPackLeader != NULL )
+		return;
+
+	CSchemeGodunov::readKeyStatistics();
+
+	if ( !this->isPackingEnabled() )
+		return;
+
+	// Already read back with the batch status block
+	for( unsigned int i = 0; i < this->vPackGuests.size(); i++ )
+	{
+		CSchemePromaides*	pGuest					= this->vPackGuests[i];
+		cl_uint				uiLastBatchSuccessful	= pGuest->uiBatchSuccessful;
+
+		if ( cModel->getFloatPrecision() != model::floatPrecision::kDouble )
+		{
+			pGuest->dCurrentTime		= static_cast<cl_double>( oclBufferPackTime->getHostBlock<cl_float*>()[ i ] );
+			pGuest->dCurrentTimestep	= static_cast<cl_double>( oclBufferPackTimestep->getHostBlock<cl_float*>()[ i ] );
+			pGuest->dBatchTimesteps		= static_cast<cl_double>( oclBufferPackBatchTimesteps->getHostBlock<cl_float*>()[ i ] );
+		} else {
+			pGuest->dCurrentTime		= oclBufferPackTime->getHostBlock<cl_double*>()[ i ];
+			pGuest->dCurrentTimestep	= oclBufferPackTimestep->getHostBlock<cl_double*>()[ i ];
+			pGuest->dBatchTimesteps		= oclBufferPackBatchTimesteps->getHostBlock<cl_double*>()[ i ];
+		}
+		pGuest->uiBatchSuccessful	= oclBufferPackBatchSuccessful->getHostBlock<cl_uint*>()[ i ];
+		pGuest->uiBatchSkipped		= oclBufferPackBatchSkipped->getHostBlock<cl_uint*>()[ i ];
+		pGuest->uiBatchRate			= pGuest->uiBatchSuccessful > uiLastBatchSuccessful ? ( pGuest->uiBatchSuccessful - uiLastBatchSuccessful ) : 1;
+		pGuest->ulCurrentCellsCalculated += pGuest->pDomain->getCellCount() * ( pGuest->uiBatchSuccessful > uiLastBatchSuccessful ? ( pGuest->uiBatchSuccessful - uiLastBatchSuccessful ) : 0 );
+
+		this->dCurrentTime = min( this->dCurrentTime, pGuest->dCurrentTime );
+	}
+}
+
+/*
+ *  Run this simulation until the specified time, which for a packed
+ *  floodplain is done by the leader's batches
+ */
+void	CSchemePromaides::runSimulation( double dTargetTime, double dRealTime )
+{
+	if ( this->pPackLeader != NULL )
+		return;
+
+	CSchemeGodunov::runSimulation( dTargetTime, dRealTime );
+}
+
+/*
+ *  Clean-up temporary resources consumed during the simulation
+ */
+void	CSchemePromaides::cleanupSimulation()
+{
+	if ( this->pPackLeader != NULL )
+		return;
+
+	CSchemeGodunov::cleanupSimulation();
+}
+
+/*
+ *  Save current cell states incase of need to rollback
+ */
+void	CSchemePromaides::saveCurrentState()
+{
+	if ( this->pPackLeader != NULL )
+	{
+		this->pPackLeader->readPackedGuest( this );
+		this->uiIterationsSinceSync = 0;
+		return;
+	}
+
+	CSchemeGodunov::saveCurrentState();
+}
+
+/*
+ *  Roll back cell states to the last successful round, which packed
+ *  floodplains do not support
+ */
+void	CSchemePromaides::rollbackSimulation( double dCurrentTime, double dTargetTime )
+{
+	if ( this->pPackLeader != NULL )
+		return;
+
+	CSchemeGodunov::rollbackSimulation( dCurrentTime, dTargetTime );
+}
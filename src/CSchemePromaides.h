@@ -39,17 +39,88 @@ class CSchemePromaides : public CSchemeGodunov
 		// Public functions
 		virtual void		logDetails();									// Write some details about the scheme
 		virtual void		prepareAll();									// Prepare absolutely everything for a model run
+		virtual void		scheduleIteration( bool,						// Schedule an iteration of the scheme
+											   COCLDevice*,
+											   CDomain* );
 		void				setCacheMode( unsigned char );					// Set the cache configuration
 		unsigned char		getCacheMode();									// Get the cache configuration
 		void				setCacheConstraints( unsigned char );			// Set LDS cache size constraints
 		unsigned char		getCacheConstraints();							// Get LDS cache size constraints
+		void				setPackLeader( CSchemePromaides* );				// Pack this floodplain into another scheme's launches
+		CSchemePromaides*	getPackLeader();								// Get the scheme this floodplain is packed into
+
+		virtual void		readDomainAll();								// Read back all domain data
+		virtual void		readDomainFSL();								// Read back the free-surface levels
+		virtual void		importLinkZoneData();							// Load in data
+		virtual void		prepareSimulation();							// Set everything up to start running for this domain
+		virtual void		readKeyStatistics();							// Fetch the key details back to the right places in memory
+		virtual void		runSimulation( double, double );				// Run this simulation until the specified time
+		virtual void		cleanupSimulation();							// Dispose of transient data and clean-up this domain
+		virtual void		saveCurrentState();								// Save current cell states
+		virtual void		rollbackSimulation( double, double );			// Roll back cell states to the last successful round
 
 	protected:
 
 		// Private functions
 		virtual bool		prepareCode();									// Prepare the code required
 		virtual void		releaseResources();								// Release OpenCL resources consumed
+		bool				preparePromaidesConstants();					// Assign constants to the executor
+		bool				preparePromaidesMemory();						// Prepare memory buffers required
 		bool				preparePromaidesKernels();						// Prepare the kernels required
+		virtual bool		prepareAlternateKernels();						// Prepare the kernels with source and destination swapped
 		void				releasePromaidesResources();						// Release OpenCL resources consumed
+		bool				isPoleniFacesEnabled();							// Are weir faces solved by their own kernel?
+		bool				isFaceConductanceEnabled();						// Are the face conductances precomputed?
+		virtual bool		isPersistentLoopEnabled();						// Does each batch run from a single launch?
+		virtual bool		isTemporalBlockingEnabled();					// Does the flux kernel advance several timesteps?
+		virtual bool		isStripMiningEnabled();							// Does each flux work-item walk up a strip of cells?
+		virtual bool		isStaticImagesEnabled();						// Are the bed and Manning values read as images?
+		virtual bool		isManningImageEnabled();						// Does the flux kernel read the Manning values as an image?
+		virtual bool		isZeroTimestepSkipEnabled();					// Are zero-timestep iterations skipped without a copy?
+		virtual std::string	getAutotuneScheme();							// Scheme name used in the tuning cache key
+		virtual std::string	getAutotuneKey();								// Tuning cache key for this device and scheme
+		virtual void		scheduleBoundaryWrite( COCLDevice* );			// Write the imported boundary values to the device
+		void				preparePackedGuest();							// Prepare a floodplain packed into another scheme
+		bool				isPackingEnabled();								// Are packed floodplains updated alongside this one?
+		cl_ulong			getPackStatusSize( unsigned char );				// Bytes of one packed status array in the batch status block
+		virtual cl_ulong	getBatchStatusExtraSize();						// Bytes of the packed floodplains' status read back per batch
+		void				schedulePackedCells( bool, COCLDevice* );		// Schedule the cell update of the packed floodplains
+		void				schedulePackedAdvance( COCLDevice* );			// Schedule the time advance of the packed floodplains
+		void				readPackedGuest( CSchemePromaides* );			// Read back the states of a packed floodplain
+
+		// Packed floodplains
+		CSchemePromaides*				pPackLeader;						// Scheme this floodplain is packed into
+		std::vector<CSchemePromaides*>	vPackGuests;						// Floodplains packed into this scheme
+		cl_ulong						ulPackCellCount;					// Packed cells, including padding
+		cl_ulong						ulPackOffset;						// First packed cell of this floodplain
+		void*							pPackCellStates;					// Host cell states of this floodplain
+		void*							pPackBedElevations;					// Host bed elevations of this floodplain
+		void*							pPackManningValues;					// Host Manning coefficients of this floodplain
+		void*							pPackBoundaryValues;				// Host boundary values of this floodplain
+
+		// OpenCL elements
+		COCLKernel*			oclKernelFaceFluxes;
+		COCLKernel*			oclKernelPoleniFaces;
+		COCLBuffer*			oclBufferFaceFluxes;
+		COCLBuffer*			oclBufferWeirFaceFluxes;
+		COCLKernel*			oclKernelFaceConductances;
+		COCLBuffer*			oclBufferFaceConductances;
+		COCLKernel*			oclKernelPackedCells;
+		COCLKernel*			oclKernelPackedAdvance;
+		COCLBuffer*			oclBufferPackStates;
+		COCLBuffer*			oclBufferPackStatesAlt;
+		COCLBuffer*			oclBufferPackBed;
+		COCLBuffer*			oclBufferPackManning;
+		COCLBuffer*			oclBufferPackBoundary;
+		COCLBuffer*			oclBufferPackOffsets;
+		COCLBuffer*			oclBufferPackDims;
+		COCLBuffer*			oclBufferPackResolution;
+		COCLBuffer*			oclBufferPackTime;
+		COCLBuffer*			oclBufferPackTimestep;
+		COCLBuffer*			oclBufferPackTimeHydrological;
+		COCLBuffer*			oclBufferPackBatchTimesteps;
+		COCLBuffer*			oclBufferPackBatchSuccessful;
+		COCLBuffer*			oclBufferPackBatchSkipped;
+		COCLBuffer*			oclBufferPackReduction;
 
 };
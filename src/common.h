@@ -48,13 +48,6 @@
 #include <stdexcept>
 #include <thread>
 
-struct sUsePoleni {
-	bool	usePoliniN;
-	bool	usePoliniE;
-	bool	usePoliniS;
-	bool	usePoliniW;
-};
-
 // Basic functions and variables used throughout
 namespace model
 {
@@ -78,7 +71,8 @@ namespace model
 	namespace floatPrecision{
 		enum floatPrecision {
 			kSingle = 0,	// Single-precision
-			kDouble = 1		// Double-precision
+			kDouble = 1,	// Double-precision
+			kDoubleFloat = 2	// Single-precision storage, with the state update emulated as double-float
 		};
 	}
 
@@ -133,7 +127,8 @@ namespace model
 		namespace promaidesFormula {
 			enum promaidesFormula {
 				kCacheNone = 0,		// No caching
-				kCacheEnabled = 1			// Cache cell state data
+				kCacheEnabled = 1,			// Cache cell state data
+				kFaceCentred = 2			// Solve each face once, then accumulate into cells
 			};
 		}
 	}
@@ -190,6 +185,16 @@ namespace model
 		};
 	}
 
+	// Poleni (weir) flags held in each cell's face bitmask
+	namespace poleniFaces {
+		enum poleniFaces {
+			kFaceN = 1,	// North face
+			kFaceE = 2,	// East face
+			kFaceS = 4,	// South face
+			kFaceW = 8	// West face
+		};
+	}
+
 	extern  char*			configFile;
 	extern  char*			codeDir;
 	void					doError( std::string, unsigned char );
@@ -324,6 +329,23 @@ namespace model
 		//unsigned char CacheConstraints = model::cacheConstraints::godunovType::kCacheAllowOversize;
 		//unsigned char CacheConstraints = model::cacheConstraints::godunovType::kCacheAllowUndersize;
 		bool ExtrapolatedContiguity = false;
+		bool ReductionInFluxKernel = false;
+		bool BoundaryInFluxKernel = false;
+		bool ActiveTiles = false;
+		unsigned int ActiveTilesInterval = 8;
+		bool WetExtent = false;
+		bool CellStateSoA = false;
+		bool MixedPrecision = false;
+		bool DepthEncoding = false;
+		unsigned int CellTileRows = 0;
+		unsigned int TemporalBlockSteps = 1;
+		unsigned int StripCells = 1;
+		bool StaticImages = false;
+		bool PersistentLoop = false;
+		bool AtomicReduction = false;
+		bool OutOfOrderQueue = false;
+		bool Autotune = false;
+		std::string AutotuneCacheFile = "autotune.cache";
 	
 	};
 